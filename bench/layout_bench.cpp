@@ -0,0 +1,92 @@
+/**
+ * @file layout_bench.cpp
+ * @author GraY
+ * @brief Benchmark of @b Stack layout under multi-threaded load.
+ * Every thread works with it`s own stack, so any slowdown with more threads comes from neighbour descriptors
+ * sharing cache lines. Build with different @b STACK_ALIGN to compare layouts.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "../include/stack.h"
+
+static const size_t Default_n_ops = 1000000;
+static const size_t Capacity      = 8;
+static const size_t Base_size     = 4; ///< Size at which push + pop neither expands nor shrinks the stack.
+
+/**
+ * @brief Pushes and pops @b n_ops elements from the stack.
+ */
+static void thread_work(Stack_context *context, const stk_d stack_descriptor, const size_t n_ops)
+{
+    for(size_t i = 0; i < n_ops; i++)
+    {
+        push_stack(context, stack_descriptor, (elem_t)i);
+        pop_stack (context, stack_descriptor);
+    }
+}
+
+/**
+ * @brief Runs @b n_threads threads on neighbour stacks and returns nanoseconds per operation.
+ * Every run has it`s own context, so the descriptor table fits any number of threads and starts empty.
+ */
+static double run(const size_t n_threads, const size_t n_ops)
+{
+    Stack_library_config config = {};
+    config.max_stacks = n_threads + 1; // Descriptor 0 is never given out.
+
+    Stack_context *context = NULL;
+    if(stack_library_init(&context, &config)) return -1;
+
+    std::vector<stk_d> stacks(n_threads, 0);
+
+    for(size_t i = 0; i < n_threads; i++)
+    {
+        if(stack_ctor(context, &stacks[i], Capacity))
+        {
+            stack_library_destroy(context);
+
+            return -1;
+        }
+
+        for(size_t j = 0; j < Base_size; j++) push_stack(context, stacks[i], (elem_t)j);
+    }
+
+    std::vector<std::thread> threads;
+    threads.reserve(n_threads);
+
+    auto start = std::chrono::steady_clock::now();
+
+    for(size_t i = 0; i < n_threads; i++) threads.emplace_back(thread_work, context, stacks[i], n_ops);
+    for(std::thread &thread: threads) thread.join();
+
+    auto finish = std::chrono::steady_clock::now();
+
+    for(size_t i = 0; i < n_threads; i++) stack_dtor(context, stacks[i]);
+
+    stack_library_destroy(context);
+
+    return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(finish - start).count() / (double)(2 * n_ops);
+}
+
+int main(int argc, char *argv[])
+{
+    size_t max_threads = std::thread::hardware_concurrency();
+    if(max_threads < 2) max_threads = 2;
+
+    size_t n_ops = (argc > 1) ? strtoull(argv[1], NULL, 10) : Default_n_ops;
+
+    printf("sizeof(Stack) = %zu, alignof(Stack) = %zu, STACK_ALIGN = %d\n", sizeof(Stack), alignof(Stack), STACK_ALIGN);
+
+    for(size_t n_threads = 1; n_threads <= max_threads; n_threads *= 2)
+    {
+        printf("threads = %2zu: %8.2f ns/op\n", n_threads, run(n_threads, n_ops));
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,107 @@
+/**
+ * @file vm_bench.cpp
+ * @author GraY
+ * @brief Benchmark of the bytecode evaluator against per-operation stack API.
+ * Both evaluate ((a + b) * c - d) * e many times on the same stack.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <chrono>
+
+#include "../include/stack.h"
+#include "../include/stack_vm.h"
+
+static const size_t Default_n_evals = 100000;
+static const size_t Capacity        = 16;
+
+static const elem_t A = 1, B = 2, C = 3, D = 4, E = 5;
+static const elem_t Expected = ((A + B) * C - D) * E;
+
+/**
+ * @brief Binary operation with per-operation API: two pops and one push, each fully verified.
+ */
+#define API_BINARY(stack_descriptor, op)    { \
+                                                elem_t b = 0; \
+                                                elem_t a = 0; \
+                                                \
+                                                pop_stack (stack_descriptor, &b); \
+                                                pop_stack (stack_descriptor, &a); \
+                                                push_stack(stack_descriptor, a op b); \
+                                            }
+
+static elem_t eval_api(const stk_d stack_descriptor)
+{
+    push_stack(stack_descriptor, A);
+    push_stack(stack_descriptor, B);
+    API_BINARY(stack_descriptor, +);
+    push_stack(stack_descriptor, C);
+    API_BINARY(stack_descriptor, *);
+    push_stack(stack_descriptor, D);
+    API_BINARY(stack_descriptor, -);
+    push_stack(stack_descriptor, E);
+    API_BINARY(stack_descriptor, *);
+
+    elem_t result = 0;
+    pop_stack(stack_descriptor, &result);
+
+    return result;
+}
+
+static elem_t eval_vm(const stk_d stack_descriptor)
+{
+    static const Vm_instr Code[] = {{VM_PUSH, A}, {VM_PUSH, B}, {VM_ADD, 0},
+                                    {VM_PUSH, C}, {VM_MUL,  0},
+                                    {VM_PUSH, D}, {VM_SUB,  0},
+                                    {VM_PUSH, E}, {VM_MUL,  0}};
+
+    stack_vm_run(stack_descriptor, Code, sizeof(Code) / sizeof(Code[0]));
+
+    elem_t result = 0;
+    pop_stack(stack_descriptor, &result);
+
+    return result;
+}
+
+/**
+ * @brief Runs @b eval @b n_evals times and returns nanoseconds per evaluation.
+ */
+static double run(elem_t (*eval)(const stk_d), const size_t n_evals)
+{
+    stk_d stack_descriptor = 0;
+    if(stack_ctor(&stack_descriptor, Capacity)) return -1;
+
+    push_stack(stack_descriptor, 0); // Keeps the stack from shrinking.
+
+    auto start = std::chrono::steady_clock::now();
+
+    for(size_t i = 0; i < n_evals; i++)
+    {
+        if(eval(stack_descriptor) != Expected)
+        {
+            fprintf(stderr, "Wrong result.\n");
+
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    auto finish = std::chrono::steady_clock::now();
+
+    stack_dtor(stack_descriptor);
+
+    return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(finish - start).count() / (double)n_evals;
+}
+
+int main(int argc, char *argv[])
+{
+    size_t n_evals = (argc > 1) ? strtoull(argv[1], NULL, 10) : Default_n_evals;
+
+    double api_ns = run(eval_api, n_evals);
+    double vm_ns  = run(eval_vm,  n_evals);
+
+    printf("per-op API: %10.2f ns/expression\n"
+           "evaluator:  %10.2f ns/expression (x%.1f)\n", api_ns, vm_ns, api_ns / vm_ns);
+
+    return EXIT_SUCCESS;
+}
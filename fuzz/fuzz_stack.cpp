@@ -0,0 +1,310 @@
+/**
+ * @file fuzz_stack.cpp
+ * @author GraY
+ * @brief Fuzzing harness for the @b Stack.
+ *
+ * Input bytes are decoded into a sequence of operations, which are run on a real stack and on a reference model.
+ * Harness aborts on any mismatch and on any protection error without corruption, so it needs no sanitizers.
+ * Every input runs in it`s own library context, big enough for every stack the input may create.
+ * Built with @b STACK_LIBFUZZER it is a libFuzzer target, otherwise it reads input from files, stdin (AFL)
+ * or generates random inputs with "-random N".
+ */
+
+#include <errno.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <vector>
+
+#include "../include/stack.h"
+
+#define FUZZ_CHECK(condition)   if(!(condition)) \
+                                { \
+                                    fprintf(stderr, "%s:%d: Fuzz check failed: %s\n", __FILE__, __LINE__, #condition); \
+                                    \
+                                    abort(); \
+                                }
+
+static const size_t Max_capacity = 32;
+static const size_t Max_input    = 4096;
+
+/**
+ * @brief Operations encoded by the input.
+ */
+enum Fuzz_op
+{
+    FUZZ_PUSH,
+    FUZZ_POP,
+    FUZZ_CLEAR,
+    FUZZ_FIND,
+    FUZZ_COUNT,
+    FUZZ_REDUCE,
+    FUZZ_VIEW,
+    FUZZ_RECREATE,
+
+    N_FUZZ_OPS,
+};
+
+/**
+ * @brief Reader of the input bytes. Returns zeros after the end.
+ */
+struct Fuzz_input
+{
+    const uint8_t *data;
+    size_t         size;
+    size_t         pos;
+};
+
+static uint8_t read_byte(Fuzz_input *input)
+{
+    return (input->pos < input->size) ? input->data[input->pos++] : 0;
+}
+
+/**
+ * @brief Reads element. Small values are more likely, so find and count have something to find.
+ */
+static elem_t read_elem(Fuzz_input *input)
+{
+    uint8_t tag = read_byte(input);
+
+    if(tag & 0x80)
+    {
+        unsigned long long val = 0;
+        for(size_t i = 0; i < sizeof(elem_t); i++) val = (val << 8) | read_byte(input);
+
+        return (elem_t)val;
+    }
+
+    return (elem_t)(tag & 0x0F) - 8;
+}
+
+static stk_d recreate(Stack_context *context, const stk_d stack_descriptor, const size_t capacity, std::vector<elem_t> *model)
+{
+    if(stack_descriptor) FUZZ_CHECK(stack_dtor(context, stack_descriptor) == 0);
+
+    stk_d new_stack_descriptor = 0;
+    FUZZ_CHECK(stack_ctor(context, &new_stack_descriptor, capacity) == 0);
+
+    model->clear();
+
+    return new_stack_descriptor;
+}
+
+static void check_view(Stack_context *context, const stk_d stack_descriptor, const std::vector<elem_t> &model)
+{
+    std::span<const elem_t> view = stack_view(context, stack_descriptor);
+
+    FUZZ_CHECK(view.size() == model.size());
+
+    for(size_t i = 0; i < model.size(); i++) FUZZ_CHECK(view[i] == model[i]);
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    Fuzz_input input = {data, size, 0};
+    std::vector<elem_t> model;
+
+    Stack_library_config config = {};
+    config.max_stacks = size + 2; // Every recreation takes at least two bytes.
+
+    Stack_context *context = NULL;
+    FUZZ_CHECK(stack_library_init(&context, &config) == 0);
+
+    stk_d stack = recreate(context, 0, 1 + read_byte(&input) % Max_capacity, &model);
+
+    while(input.pos < input.size)
+    {
+        switch((Fuzz_op)(read_byte(&input) % N_FUZZ_OPS))
+        {
+            case FUZZ_PUSH:
+            {
+                elem_t val = read_elem(&input);
+
+                FUZZ_CHECK(push_stack(context, stack, val) == 0);
+                model.push_back(val);
+
+                break;
+            }
+            case FUZZ_POP:
+            {
+                elem_t val = 0;
+
+                if(model.empty())
+                {
+                    FUZZ_CHECK(pop_stack(context, stack, &val) == EINVAL);
+
+                    break;
+                }
+
+                FUZZ_CHECK(pop_stack(context, stack, &val) == 0);
+                FUZZ_CHECK(val == model.back());
+                model.pop_back();
+
+                break;
+            }
+            case FUZZ_CLEAR:
+            {
+                FUZZ_CHECK(clear_stack(context, stack) == 0);
+                model.clear();
+
+                break;
+            }
+            case FUZZ_FIND:
+            {
+                elem_t val   = read_elem(&input);
+                size_t index = 0;
+                size_t model_index = 0;
+
+                while(model_index < model.size() && model[model_index] != val) model_index++;
+
+                if(model_index == model.size())
+                {
+                    FUZZ_CHECK(stack_find(context, stack, val, &index) == ENOENT);
+                }
+                else
+                {
+                    FUZZ_CHECK(stack_find(context, stack, val, &index) == 0);
+                    FUZZ_CHECK(index == model_index);
+                }
+
+                break;
+            }
+            case FUZZ_COUNT:
+            {
+                elem_t val   = read_elem(&input);
+                size_t count = 0;
+                size_t model_count = 0;
+
+                for(elem_t elem: model) model_count += (elem == val);
+
+                FUZZ_CHECK(stack_count(context, stack, val, &count) == 0);
+                FUZZ_CHECK(count == model_count);
+
+                break;
+            }
+            case FUZZ_REDUCE:
+            {
+                unsigned long long sum = 0;
+                for(elem_t elem: model) sum += (unsigned long long)elem;
+
+                elem_t result = 0;
+                FUZZ_CHECK(stack_reduce(context, stack, REDUCE_SUM, &result) == 0);
+                FUZZ_CHECK(result == (elem_t)sum);
+
+                if(model.empty())
+                {
+                    FUZZ_CHECK(stack_reduce(context, stack, REDUCE_MIN, &result) == EINVAL);
+                    FUZZ_CHECK(stack_reduce(context, stack, REDUCE_MAX, &result) == EINVAL);
+
+                    break;
+                }
+
+                elem_t min = model[0];
+                elem_t max = model[0];
+                for(elem_t elem: model)
+                {
+                    if(elem < min) min = elem;
+                    if(elem > max) max = elem;
+                }
+
+                FUZZ_CHECK(stack_reduce(context, stack, REDUCE_MIN, &result) == 0);
+                FUZZ_CHECK(result == min);
+                FUZZ_CHECK(stack_reduce(context, stack, REDUCE_MAX, &result) == 0);
+                FUZZ_CHECK(result == max);
+
+                break;
+            }
+            case FUZZ_VIEW:
+            {
+                check_view(context, stack, model);
+
+                break;
+            }
+            case FUZZ_RECREATE:
+            {
+                stack = recreate(context, stack, 1 + read_byte(&input) % Max_capacity, &model);
+
+                break;
+            }
+            case N_FUZZ_OPS:
+            default:
+                abort();
+        }
+    }
+
+    check_view(context, stack, model);
+    FUZZ_CHECK(stack_dtor(context, stack) == 0);
+    FUZZ_CHECK(stack_library_destroy(context) == 0);
+
+    return 0;
+}
+
+#ifndef STACK_LIBFUZZER
+
+/**
+ * @brief Runs harness on the whole content of @b file.
+ */
+static void run_file(FILE *file)
+{
+    std::vector<uint8_t> input;
+
+    int byte = 0;
+    while((byte = fgetc(file)) != EOF) input.push_back((uint8_t)byte);
+
+    LLVMFuzzerTestOneInput(input.data(), input.size());
+}
+
+/**
+ * @brief Runs harness on @b n_runs random inputs.
+ */
+static void run_random(const size_t n_runs)
+{
+    std::vector<uint8_t> input(Max_input);
+
+    for(size_t run = 0; run < n_runs; run++)
+    {
+        size_t size = (size_t)rand() % Max_input;
+        for(size_t i = 0; i < size; i++) input[i] = (uint8_t)rand();
+
+        LLVMFuzzerTestOneInput(input.data(), size);
+    }
+
+    printf("%zu random inputs passed.\n", n_runs);
+}
+
+int main(int argc, char *argv[])
+{
+    if(argc == 1)
+    {
+        run_file(stdin);
+
+        return EXIT_SUCCESS;
+    }
+
+    if(argc == 3 && strcmp(argv[1], "-random") == 0)
+    {
+        run_random(strtoull(argv[2], NULL, 10));
+
+        return EXIT_SUCCESS;
+    }
+
+    for(int i = 1; i < argc; i++)
+    {
+        FILE *file = fopen(argv[i], "rb");
+        if(!file)
+        {
+            fprintf(stderr, "Can`t open %s.\n", argv[i]);
+
+            return EXIT_FAILURE;
+        }
+
+        run_file(file);
+        fclose(file);
+    }
+
+    return EXIT_SUCCESS;
+}
+
+#endif
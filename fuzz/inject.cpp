@@ -0,0 +1,222 @@
+/**
+ * @file inject.cpp
+ * @author GraY
+ * @brief Corruption-injection suite for the @b Stack protection.
+ *
+ * Flips bytes in @b Stack fields, @b data canaries and @b data payload and checks whether verification notices it.
+ * Prints detection rate for every region and cost of push + pop for the protection level it is built with,
+ * so changes of hashing and verification can be compared against a fixed baseline.
+ * Every injection runs in it`s own library context, so descriptor table is never exhausted.
+ */
+
+#include <setjmp.h>
+#include <signal.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <chrono>
+#include <vector>
+
+#include "../include/stack.h"
+
+static const size_t Default_n_trials = 10000;
+static const size_t Default_n_ops    = 1000000;
+static const size_t Capacity         = 16;
+
+/**
+ * @brief Place for byte flipping.
+ */
+struct Byte_range
+{
+    size_t offset;
+    size_t size;
+};
+
+/**
+ * @brief Regions of the @b Stack to corrupt.
+ */
+enum Region
+{
+    REGION_STACK,
+    REGION_CANARIES,
+    REGION_PAYLOAD,
+
+    N_REGIONS,
+};
+
+static const char *Region_names[N_REGIONS] = {"stack", "canaries", "payload"};
+
+/**
+ * @brief Outcome of one injection.
+ */
+struct Region_stats
+{
+    size_t detected;
+    size_t missed;
+    size_t crashed; ///< Verification itself faulted on corrupted pointer or size.
+};
+
+static sigjmp_buf Fault_env;
+
+static void fault_handler(int)
+{
+    siglongjmp(Fault_env, 1);
+}
+
+#define FIELD_RANGE(field) Byte_range{offsetof(Stack, field), sizeof(((Stack *)NULL)->field)}
+
+/**
+ * @brief Byte ranges of all protected @b Stack fields present in the current configuration.
+ * @b err is left out: every verification fills it anew.
+ */
+static std::vector<Byte_range> stack_fields(void)
+{
+    std::vector<Byte_range> fields = {FIELD_RANGE(size), FIELD_RANGE(capacity), FIELD_RANGE(data)};
+
+#if STACK_CANARY
+    fields.push_back(FIELD_RANGE(canary_left));
+    fields.push_back(FIELD_RANGE(canary_right));
+#endif
+
+#if STACK_HASH
+    fields.push_back(FIELD_RANGE(stack_hash));
+    fields.push_back(FIELD_RANGE(data_hash));
+#endif
+
+    return fields;
+}
+
+#undef FIELD_RANGE
+
+/**
+ * @brief Chooses random byte in @b region of @b stack.
+ * @return char* Pointer to the byte or @b NULL if region does not exist in current configuration.
+ */
+static char *random_byte(Stack *stack, const Region region, const std::vector<Byte_range> &fields)
+{
+    switch(region)
+    {
+        case REGION_STACK:
+        {
+            const Byte_range &field = fields[(size_t)rand() % fields.size()];
+
+            return (char *)stack + field.offset + (size_t)rand() % field.size;
+        }
+        case REGION_CANARIES:
+        {
+#if STACK_CANARY
+            char *canary = (rand() % 2) ? (char *)(stack->data + stack->capacity) : (char *)stack->data - sizeof(canary_t);
+
+            return canary + (size_t)rand() % sizeof(canary_t);
+#else
+            return NULL;
+#endif
+        }
+        case REGION_PAYLOAD:
+            return (char *)stack->data + (size_t)rand() % (stack->capacity * sizeof(elem_t));
+        case N_REGIONS:
+        default:
+            abort();
+    }
+}
+
+/**
+ * @brief Corrupts one byte of a fresh stack and runs verification like every operation does.
+ */
+static void inject(const Region region, const std::vector<Byte_range> &fields, Region_stats *stats)
+{
+    Stack_context *context = NULL;
+    if(stack_library_init(&context)) abort();
+
+    stk_d stack_descriptor = 0;
+    if(stack_ctor(context, &stack_descriptor, Capacity)) abort();
+
+    size_t n_elems = 1 + (size_t)rand() % Capacity;
+    for(size_t i = 0; i < n_elems; i++) push_stack(context, stack_descriptor, (elem_t)rand());
+
+    Stack *stack = stack_raw(context, stack_descriptor);
+
+    char *byte = random_byte(stack, region, fields);
+    if(!byte) abort();
+
+    char original = *byte;
+    *byte = (char)(original ^ (1 + rand() % 255));
+
+    if(sigsetjmp(Fault_env, 1))
+    {
+        stats->crashed++;
+    }
+    else if(stack_validation(context, stack_descriptor) || stack_data_validation(context, stack_descriptor))
+    {
+        stats->detected++;
+    }
+    else
+    {
+        stats->missed++;
+    }
+
+    *byte = original;
+
+    stack_library_destroy(context);
+}
+
+/**
+ * @brief Measures nanoseconds per push or pop.
+ */
+static double op_cost(const size_t n_ops)
+{
+    stk_d stack_descriptor = 0;
+    if(stack_ctor(&stack_descriptor, Capacity)) abort();
+
+    for(size_t i = 0; i < Capacity / 2; i++) push_stack(stack_descriptor, (elem_t)i);
+
+    auto start = std::chrono::steady_clock::now();
+
+    for(size_t i = 0; i < n_ops; i++)
+    {
+        push_stack(stack_descriptor, (elem_t)i);
+        pop_stack (stack_descriptor);
+    }
+
+    auto finish = std::chrono::steady_clock::now();
+
+    stack_dtor(stack_descriptor);
+
+    return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(finish - start).count() / (double)(2 * n_ops);
+}
+
+int main(int argc, char *argv[])
+{
+    size_t n_trials = (argc > 1) ? strtoull(argv[1], NULL, 10) : Default_n_trials;
+    size_t n_ops    = (argc > 2) ? strtoull(argv[2], NULL, 10) : Default_n_ops;
+
+    struct sigaction action = {};
+    action.sa_handler = fault_handler;
+    sigaction(SIGSEGV, &action, NULL);
+    sigaction(SIGBUS,  &action, NULL);
+
+    srand(0);
+
+    std::vector<Byte_range> fields = stack_fields();
+
+    printf("Protection: canary = %d, hash = %d\n", STACK_CANARY, STACK_HASH);
+    printf("push/pop:   %.2f ns/op\n", op_cost(n_ops));
+    printf("%-10s %10s %10s %10s\n", "region", "detected", "missed", "crashed");
+
+    for(int region = 0; region < N_REGIONS; region++)
+    {
+        if(region == REGION_CANARIES && !STACK_CANARY) continue;
+
+        Region_stats stats = {};
+
+        for(size_t trial = 0; trial < n_trials; trial++) inject((Region)region, fields, &stats);
+
+        printf("%-10s %9.2f%% %9.2f%% %9.2f%%\n", Region_names[region], 100.0 * (double)stats.detected / (double)n_trials,
+                                                                       100.0 * (double)stats.missed   / (double)n_trials,
+                                                                       100.0 * (double)stats.crashed  / (double)n_trials);
+    }
+
+    return EXIT_SUCCESS;
+}
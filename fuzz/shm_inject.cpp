@@ -0,0 +1,168 @@
+/**
+ * @file shm_inject.cpp
+ * @author GraY
+ * @brief Crash-injection suite for the shared stack.
+ *
+ * Child process locks the shared stack, optionally corrupts it and is killed holding the lock. Parent checks that
+ * consistent stack is taken over and corrupted one becomes unusable (@b ENOTRECOVERABLE). Corrupted header without
+ * crash should be refused with @b EINVAL instead of faulting. The suite is built together with shm_stack.cpp,
+ * so it can lock and corrupt the segment the way a crashed writer does.
+ */
+
+#include <signal.h>
+#include <sys/wait.h>
+
+#include "../source/shm_stack.cpp"
+
+#define SHM_CHECK(condition)    if(!(condition)) \
+                                { \
+                                    fprintf(stderr, "%s:%d: Shared stack check failed: %s\n", __FILE__, __LINE__, #condition); \
+                                    \
+                                    abort(); \
+                                }
+
+static const size_t Capacity = 16;
+static const size_t N_elems  = 8;
+
+/**
+ * @brief What the killed lock holder does to the stack.
+ */
+enum Crash
+{
+    CRASH_CLEAN,    ///< Nothing, stack stays consistent.
+    CRASH_PAYLOAD,  ///< Half-written push: element is written, hashes are not updated.
+    CRASH_CAPACITY, ///< Header field is overwritten.
+};
+
+static elem_t *segment_data(Shm_header *header)
+{
+    return (elem_t *)((char *)header + header->data_offset);
+}
+
+/**
+ * @brief Creates shared stack @b name with @b N_elems elements.
+ */
+static void fill(Shm_stack *stack, const char *name)
+{
+    shm_stack_unlink(name);
+
+    SHM_CHECK(shm_stack_create(stack, name, Capacity) == 0);
+
+    for(size_t i = 0; i < N_elems; i++) SHM_CHECK(shm_stack_push(stack, (elem_t)i) == 0);
+}
+
+/**
+ * @brief Forks a process which locks the stack, does @b crash to it and is killed holding the lock.
+ */
+static void kill_lock_holder(Shm_stack *stack, const Crash crash)
+{
+    pid_t pid = fork();
+    SHM_CHECK(pid >= 0);
+
+    if(pid == 0)
+    {
+        Shm_header *header = stack->header;
+
+        pthread_mutex_lock(&header->mutex);
+
+        header->writer_pid = getpid();
+
+        switch(crash)
+        {
+            case CRASH_CLEAN:
+                break;
+            case CRASH_PAYLOAD:
+                segment_data(header)[header->size] = 0xDEAD;
+                header->size++;
+                break;
+            case CRASH_CAPACITY:
+                header->capacity = (size_t)1 << 40;
+                break;
+            default:
+                break;
+        }
+
+        kill(getpid(), SIGKILL);
+    }
+
+    int status = 0;
+    SHM_CHECK(waitpid(pid, &status, 0) == pid);
+    SHM_CHECK(WIFSIGNALED(status) && WTERMSIG(status) == SIGKILL);
+}
+
+static void check_takeover(const char *name)
+{
+    Shm_stack stack = {};
+    fill(&stack, name);
+
+    kill_lock_holder(&stack, CRASH_CLEAN);
+
+    SHM_CHECK(shm_stack_push(&stack, 100) == 0);
+
+    size_t size = 0;
+    SHM_CHECK(shm_stack_size(&stack, &size) == 0);
+    SHM_CHECK(size == N_elems + 1);
+    SHM_CHECK(shm_stack_validation(&stack) == 0);
+
+    elem_t val = 0;
+    SHM_CHECK(shm_stack_pop(&stack, &val) == 0);
+    SHM_CHECK(val == 100);
+
+    shm_stack_close(&stack);
+    shm_stack_unlink(name);
+
+    printf("%-28s passed\n", "takeover after clean crash");
+}
+
+static void check_not_recoverable(const char *name, const Crash crash, const char *title)
+{
+    Shm_stack stack = {};
+    fill(&stack, name);
+
+    kill_lock_holder(&stack, crash);
+
+    SHM_CHECK(shm_stack_push(&stack, 100) == ENOTRECOVERABLE);
+
+    size_t size = 0;
+    SHM_CHECK(shm_stack_size(&stack, &size) == ENOTRECOVERABLE);
+    SHM_CHECK(shm_stack_pop(&stack) == ENOTRECOVERABLE);
+
+    shm_stack_close(&stack);
+    shm_stack_unlink(name);
+
+    printf("%-28s passed\n", title);
+}
+
+static void check_corrupted_header(const char *name)
+{
+    Shm_stack stack = {};
+    fill(&stack, name);
+
+    stack.header->capacity = (size_t)1 << 40;
+
+    SHM_CHECK(shm_stack_push(&stack, 100) == EINVAL);
+    SHM_CHECK(shm_stack_pop(&stack) == EINVAL);
+    SHM_CHECK(shm_stack_validation(&stack) == EINVAL);
+
+    stack.header->capacity = Capacity;
+
+    SHM_CHECK(shm_stack_validation(&stack) == 0);
+
+    shm_stack_close(&stack);
+    shm_stack_unlink(name);
+
+    printf("%-28s passed\n", "corrupted capacity");
+}
+
+int main(void)
+{
+    char name[64] = "";
+    snprintf(name, sizeof(name), "/stack_shm_inject_%d", getpid());
+
+    check_takeover(name);
+    check_not_recoverable(name, CRASH_PAYLOAD,  "crash in the middle of push");
+    check_not_recoverable(name, CRASH_CAPACITY, "crash with corrupted header");
+    check_corrupted_header(name);
+
+    return EXIT_SUCCESS;
+}
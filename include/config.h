@@ -0,0 +1,86 @@
+#ifndef CONFIG_H
+#define CONFIG_H
+
+/**
+ * @file config.h
+ * @author GraY
+ * @brief Compile-time configuration of the @b Stack.
+ *
+ * Every policy is chosen by a macro that can be overridden with @b -D flag.
+ * Protection policies are on by default and off if @b NDEBUG is defined.
+ * All configuration dependent entities live in an inline namespace named after the configuration,
+ * so differently configured stacks can be linked into one binary.
+ */
+
+#include <stddef.h>
+
+#ifdef NDEBUG
+#define STACK_DEFAULT_PROTECT 0
+#else
+#define STACK_DEFAULT_PROTECT 1
+#endif
+
+#ifndef STACK_CANARY
+#define STACK_CANARY STACK_DEFAULT_PROTECT ///< Canary policy: 1 - canaries around @b Stack and it`s @b data, 0 - none.
+#endif
+
+#ifndef STACK_HASH
+#define STACK_HASH STACK_DEFAULT_PROTECT ///< Hash policy: 1 - @b Stack and @b data are hashed, 0 - none.
+#endif
+
+#ifndef STACK_GROWTH
+#define STACK_GROWTH 2 ///< Growth policy: factor of @b data expansion and shrinking.
+#endif
+
+#ifndef STACK_LOG
+#define STACK_LOG 1 ///< Logging sink policy: 1 - messages are written to @b LOG_FILE, 0 - discarded.
+#endif
+
+#ifndef STACK_ALIGN
+#define STACK_ALIGN 64 ///< Layout policy: alignment of every @b Stack and it`s @b data (cache-line size), 0 - packed.
+#endif
+
+#ifndef STACK_THREAD_SAFE
+#define STACK_THREAD_SAFE 0 ///< Thread-safety policy: 1 - every @b Stack is guarded by it`s own lock, 0 - none.
+#endif
+
+/**
+ * @brief Any verification is done only if at least one protection policy is on.
+ */
+#if STACK_CANARY || STACK_HASH
+#define STACK_PROTECT 1
+#else
+#define STACK_PROTECT 0
+#endif
+
+#define STACK_CONCAT_(a, b, c, d, e, f, g, h, i, j, k, l) a##b##c##d##e##f##g##h##i##j##k##l
+#define STACK_CONCAT(...) STACK_CONCAT_(__VA_ARGS__)
+
+/**
+ * @brief Name of the inline namespace for current configuration.
+ */
+#define STACK_ABI_NS STACK_CONCAT(stack_c, STACK_CANARY, _h, STACK_HASH, _g, STACK_GROWTH, _l, STACK_LOG, _a, STACK_ALIGN, _t, STACK_THREAD_SAFE)
+
+/**
+ * @brief Compile-time configuration of the @b Stack.
+ */
+struct Stack_config
+{
+    bool   canary;      ///< Canary policy.
+    bool   hash;        ///< Hash policy.
+    size_t growth;      ///< Growth policy.
+    bool   log;         ///< Logging sink policy.
+    size_t align;       ///< Layout policy.
+    bool   thread_safe; ///< Thread-safety policy.
+};
+
+/**
+ * @brief Configuration used in current translation unit.
+ */
+constexpr Stack_config Config = {STACK_CANARY, STACK_HASH, STACK_GROWTH, STACK_LOG, STACK_ALIGN, STACK_THREAD_SAFE};
+
+static_assert(Config.growth >= 2, "Growth factor should be at least 2.");
+static_assert((Config.align & (Config.align - 1)) == 0, "Alignment should be a power of 2.");
+static_assert(Config.align == 0 || Config.align >= sizeof(unsigned long long), "Alignment should fit a canary.");
+
+#endif //CONFIG_H
@@ -0,0 +1,121 @@
+#ifndef ERROR_REPORT_H
+#define ERROR_REPORT_H
+
+/**
+ * @file error_report.h
+ * @author GraY
+ * @brief Structured, deduplicated and rate-limited error reporting.
+ *
+ * Every error is described by a machine-readable record. Repeated errors from the same stack and call site are
+ * reported at most once per @b Error_dedup_window_ms, all reports are limited to @b stack_error_rate_limit() per second.
+ * Handler, deduplication table and rate limit live in @b Error_reporter, every library context has it`s own.
+ */
+
+#include <stddef.h>
+#include <stdio.h>
+
+#include <mutex>
+
+#include "types.h"
+
+const size_t Error_dedup_window_ms      = 1000; ///< Same error from the same call site is reported once per window.
+const size_t Error_dedup_slots          = 64;   ///< Size of the deduplication table.
+const size_t Default_reports_per_second = 16;   ///< Rate limit by default.
+
+/**
+ * @brief Machine-readable record of the @b Stack error.
+ */
+struct Stack_error
+{
+    stk_d        descriptor; ///< Stack descriptor.
+    int          err_code;   ///< Returned error code.
+    unsigned int err_bits;   ///< @b Err bit-field of the @b Stack.
+    size_t       stack_hash; ///< Stored hash of the @b Stack.
+    size_t       data_hash;  ///< Stored hash of the @b Stack data.
+    const char  *file;       ///< Call site file.
+    const char  *func;       ///< Call site function.
+    int          line;       ///< Call site line.
+    size_t       n_repeats;  ///< Number of same errors suppressed since the previous report.
+    bool         logged;     ///< Record is written to log-file, not suppressed as a duplicate or by the rate limit.
+};
+
+/**
+ * @brief What to do with the @b Stack after error.
+ */
+enum Error_action
+{
+    ERROR_LOG,        ///< Log record and return error code.
+    ERROR_ABORT,      ///< Log record and abort the program.
+    ERROR_QUARANTINE, ///< Log record and refuse all further operations with the @b Stack except destruction.
+};
+
+/**
+ * @brief Error handler. Called for every record that is not deduplicated, in the thread that found the error.
+ * With @b STACK_THREAD_SAFE that thread holds the lock of the @b Stack: handler may use the @b Stack itself,
+ * but must not wait for other threads that use it.
+ */
+typedef Error_action (*error_handler_t)(const Stack_error *error);
+
+/**
+ * @brief Last report of errors with the same key.
+ */
+struct Dedup_slot
+{
+    bool         used;
+    stk_d        descriptor;
+    int          err_code;
+    unsigned int err_bits;
+    const char  *file;
+    int          line;
+
+    long long    last_report_ms;
+    size_t       n_suppressed;
+};
+
+/**
+ * @brief Error handler, deduplication table and rate limit of one library context.
+ */
+struct Error_reporter
+{
+    std::mutex      lock                           = {};   ///< Guards all fields, is not held while handler runs.
+    Dedup_slot      dedup_table[Error_dedup_slots] = {};   ///< Last reports by hash of the key.
+    error_handler_t handler                        = NULL; ///< Error handler, @b NULL - only log.
+
+    size_t          reports_per_second             = Default_reports_per_second; ///< Rate limit.
+    long long       rate_window_start              = 0;    ///< Start of the current rate limit window, ms.
+    size_t          n_reports_in_window            = 0;    ///< Records written in the current window.
+    size_t          n_dropped                      = 0;    ///< Records dropped since the last summary.
+};
+
+/**
+ * @brief Sets error handler of the @b reporter. @b NULL restores default handler, which only logs.
+ * @param reporter Error reporter.
+ * @param handler New error handler.
+ */
+void error_reporter_handler(Error_reporter *reporter, error_handler_t handler);
+
+/**
+ * @brief Sets max number of records written to log-file per second by the @b reporter.
+ * @param reporter Error reporter.
+ * @param max_per_second Max number of records, @b 0 disables logging of records and summaries of dropped ones.
+ */
+void error_reporter_rate_limit(Error_reporter *reporter, const size_t max_per_second);
+
+/**
+ * @brief Deduplicates, rate-limits, logs @b error and passes it to the error handler of the @b reporter.
+ * @param reporter Error reporter of the context the @b error belongs to.
+ * @param error Error record. @b n_repeats and @b logged are filled by the function.
+ * @param sink Log-file of the context the @b error belongs to.
+ * @return Error_action Action asked by the handler. Duplicates are not passed to the handler, @b ERROR_LOG for them.
+ */
+Error_action report_stack_error(Error_reporter *reporter, Stack_error *error, FILE *sink);
+
+/**
+ * @brief Writes summary of records dropped by the rate limit since the last summary.
+ * Summary is otherwise written only when the next record opens a new window, so the last burst would be lost.
+ * @param reporter Error reporter.
+ * @param sink Log-file.
+ */
+void report_stack_error_flush(Error_reporter *reporter, FILE *sink);
+
+#endif //ERROR_REPORT_H
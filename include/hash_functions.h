@@ -11,18 +11,24 @@
 
 #include "types.h"
 
+inline namespace STACK_ABI_NS
+{
+
 /**
  * @brief Function hashes @b Stack data and returns hash value.
  * @param stack Pointer to the @b Stack structure.
  * @return size_t hash value of @b Stack data.
  */
-size_t poly_hash_data(Stack *stack);
+size_t poly_hash_data(const Stack *stack);
 
 /**
  * @brief Function hashes @b Stack structure and returns hash value.
+ * @b stack_hash, @b err and @b lock fields are not hashed.
  * @param stack Pointer to the @b Stack structure.
  * @return size_t hash value of @b Stack structure.
  */
-size_t poly_hash_stack(Stack *stack);
+size_t poly_hash_stack(const Stack *stack);
+
+}
 
 #endif //HASH_FUNCTIONS_H
@@ -0,0 +1,57 @@
+#ifndef KERNELS_H
+#define KERNELS_H
+
+/**
+ * @file kernels.h
+ * @author GraY
+ * @brief Read-only SIMD kernels over arrays of @b elem_t.
+ * Best implementation for the running CPU is chosen once, at the first call.
+ */
+
+#include <stddef.h>
+
+#include "types.h"
+
+/**
+ * @brief Finds first element equal to @b val.
+ * @param data Array of elements.
+ * @param n_elems Number of elements.
+ * @param val Value to find.
+ * @return size_t Index of found element or @b n_elems if there is none.
+ */
+size_t kernel_find(const elem_t *data, const size_t n_elems, const elem_t val);
+
+/**
+ * @brief Counts elements equal to @b val.
+ * @param data Array of elements.
+ * @param n_elems Number of elements.
+ * @param val Value to count.
+ * @return size_t Number of elements equal to @b val.
+ */
+size_t kernel_count(const elem_t *data, const size_t n_elems, const elem_t val);
+
+/**
+ * @brief Sums elements. Overflow wraps around.
+ * @param data Array of elements.
+ * @param n_elems Number of elements.
+ * @return elem_t Sum of elements, @b 0 if @b n_elems is @b 0.
+ */
+elem_t kernel_sum(const elem_t *data, const size_t n_elems);
+
+/**
+ * @brief Finds minimal element.
+ * @param data Array of elements.
+ * @param n_elems Number of elements. Should be greater than zero.
+ * @return elem_t Minimal element.
+ */
+elem_t kernel_min(const elem_t *data, const size_t n_elems);
+
+/**
+ * @brief Finds maximal element.
+ * @param data Array of elements.
+ * @param n_elems Number of elements. Should be greater than zero.
+ * @return elem_t Maximal element.
+ */
+elem_t kernel_max(const elem_t *data, const size_t n_elems);
+
+#endif //KERNELS_H
@@ -9,18 +9,26 @@
 
 #include <stdio.h>
 
-#define PROTECT
+#include "config.h"
 
-#ifndef LOG_CPP
-extern FILE *LOG_FILE; //< Automaticly externs log-file when included.
-#endif
+const char *const Default_log_path = "log.log"; ///< Log-file of the default sink.
 
+/**
+ * @brief Sink of @b LOG. Translation units that log into their own sink redefine it after including this header.
+ */
+#define LOG_FILE log_file()
+
+#if STACK_LOG
 #define LOG(...) fprintf(LOG_FILE, __VA_ARGS__)
 #define LOGS(string) fputs(string, LOG_FILE)
+#else
+#define LOG(...)
+#define LOGS(string)
+#endif
 
-#ifdef PROTECT
+#if STACK_PROTECT
 /**
- * @brief ifdef PROTECT checks condition and writes result into log-file.
+ * @brief if STACK_PROTECT checks condition and writes result into log-file.
  */
 #define ASSERT(condition, action)   if(!(condition))\
                                     {\
@@ -36,14 +44,23 @@ extern FILE *LOG_FILE; //< Automaticly externs log-file when included.
 
 /**
  * @brief Opens log-file in "wb" mode with no buffering.
+ * @param path Path to the log-file.
  * @return FILE* pointer to FILE for logging.
  * returns stderr if can`t open log-file.
  */
-FILE *open_log(void);
+FILE *open_log(const char *path);
+
+/**
+ * @brief Closes log-file opened by @b open_log(). Standard streams are left open.
+ * @param file Log-file.
+ */
+void close_log(FILE *file);
 
 /**
- * @brief Called automaticly by atexit() for log-file closing.
+ * @brief Returns default sink. @b Default_log_path is opened on the first call, so nothing is created until
+ * something is logged.
+ * @return FILE* Default log-file.
  */
-void close_log(void);
+FILE *log_file(void);
 
 #endif //LOG_H
\ No newline at end of file
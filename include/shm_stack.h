@@ -0,0 +1,92 @@
+#ifndef SHM_STACK_H
+#define SHM_STACK_H
+
+/**
+ * @file shm_stack.h
+ * @author GraY
+ * @brief Stack in POSIX shared memory for handing elements between processes without copying them through sockets.
+ *
+ * Segment holds protected header and data, which are addressed by offsets, so every process can map it anywhere.
+ * Access is serialized by robust process-shared mutex. If a process dies holding it, the next one checks canaries
+ * and hashes: consistent stack is taken over, corrupted one becomes unusable (@b ENOTRECOVERABLE).
+ * Layout does not depend on stack policies, so processes built with different configurations can share stacks.
+ */
+
+#include <stddef.h>
+
+#include "types.h"
+
+struct Shm_header;
+
+/**
+ * @brief Process-local handle of the shared stack.
+ */
+struct Shm_stack
+{
+    Shm_header *header;   ///< Mapped segment.
+    size_t      map_size; ///< Size of the mapping.
+};
+
+/**
+ * @brief Creates shared stack in new segment @b name and maps it.
+ * @param stack Handle to fill.
+ * @param name Segment name, starts with '/'.
+ * @param capacity Max number of elements. Capacity of shared stack never changes.
+ * @return int Error code. @b EEXIST if segment already exists.
+ */
+int shm_stack_create(Shm_stack *stack, const char *name, const size_t capacity);
+
+/**
+ * @brief Maps existing shared stack.
+ * @param stack Handle to fill.
+ * @param name Segment name.
+ * @return int Error code. @b EAGAIN if segment is not initialized yet.
+ */
+int shm_stack_open(Shm_stack *stack, const char *name);
+
+/**
+ * @brief Unmaps shared stack. Segment stays until @b shm_stack_unlink().
+ * @param stack Handle.
+ * @return int Error code.
+ */
+int shm_stack_close(Shm_stack *stack);
+
+/**
+ * @brief Removes segment @b name. Processes which mapped it keep working with it.
+ * @param name Segment name.
+ * @return int Error code.
+ */
+int shm_stack_unlink(const char *name);
+
+/**
+ * @brief Pushes @b val into shared stack.
+ * @param stack Handle.
+ * @param val Element value to push.
+ * @return int Error code. @b ENOBUFS if stack is full.
+ */
+int shm_stack_push(Shm_stack *stack, const elem_t val);
+
+/**
+ * @brief Pops element from shared stack.
+ * @param stack Handle.
+ * @param ret_val If not @b NULL, writes removed value to @b ret_val.
+ * @return int Error code. @b EAGAIN if stack is empty.
+ */
+int shm_stack_pop(Shm_stack *stack, elem_t *ret_val = NULL);
+
+/**
+ * @brief Returns number of elements in shared stack.
+ * @param stack Handle.
+ * @param size Number of elements.
+ * @return int Error code.
+ */
+int shm_stack_size(Shm_stack *stack, size_t *size);
+
+/**
+ * @brief Fully verifies shared stack: canaries, header hash and data hash.
+ * @param stack Handle.
+ * @return int Error code. @b EINVAL if stack is corrupted.
+ */
+int shm_stack_validation(Shm_stack *stack);
+
+#endif //SHM_STACK_H
@@ -9,57 +9,80 @@
 
 #include <errno.h>
 #include <stddef.h>
+#include <stdint.h>
 #include <stdio.h>
 
-#include "types.h"
+#include <span>
 
-extern FILE *LOG_FILE; ///< Log file from log.cpp.
+#include "error_report.h"
+#include "hash_functions.h"
+#include "log.h"
+#include "types.h"
 
 /**
  * @brief Macro for convinient and detailed stack dump.
  */
 #define STACK_DUMP(stk_descriptor) stack_dump(stk_descriptor, #stk_descriptor, __FILE__, __PRETTY_FUNCTION__, __LINE__)
+/**
+ * @brief Macro for stack dump in given library @b context.
+ */
+#define STACK_CONTEXT_DUMP(context, stk_descriptor) stack_dump(context, stk_descriptor, #stk_descriptor, __FILE__, __PRETTY_FUNCTION__, __LINE__)
 
-#ifdef PROTECT
+#if STACK_PROTECT
 /**
  * @brief Macro for @b stack verification.
- * Return err-code and prints @b format_str with @b __VA_ARGS__ parametres to @b LOG_FILE on stack incorrection.
+ * Reports error through @b stack_error() and returns @b err_code on stack incorrection.
  */
-#define STACK_VERIFICATION(stack_descriptor, err_code, format_str, ...) stack_validation(stack_descriptor); \
-                                                                        if(stack_info(stack_descriptor).err.invalid) \
-                                                                        { \
-                                                                            fprintf(LOG_FILE, format_str, __VA_ARGS__); \
-                                                                            \
-                                                                            return err_code; \
-                                                                        }
+#define STACK_VERIFICATION(context, stack_descriptor, err_code) if(stack_validation(context, stack_descriptor)) \
+                                                                { \
+                                                                    return stack_error(context, stack_descriptor, err_code, __FILE__, __PRETTY_FUNCTION__, __LINE__); \
+                                                                }
 /**
  * @brief Macro for stack @b data verification.
- * Return @b EINVAL from errno.h and prints err message to @b LOG_FILE if data is corrupted.
+ * Reports error through @b stack_error() and returns @b EINVAL from errno.h if data is corrupted.
  */
-#define STACK_DATA_VERIFICATION(stack_descriptor)   stack_data_validation(stack_descriptor); \
-                                                    if(stack_info(stack_descriptor).err.invalid) \
-                                                    { \
-                                                          fprintf(LOG_FILE, "%s: In %s:%d: error: Corrupted stack data.\n", \
-                                                                 __FILE__, __PRETTY_FUNCTION__, __LINE__); \
-                                                          \
-                                                          return EINVAL; \
-                                                    }
+#define STACK_DATA_VERIFICATION(context, stack_descriptor)  if(stack_data_validation(context, stack_descriptor)) \
+                                                            { \
+                                                                return stack_error(context, stack_descriptor, EINVAL, __FILE__, __PRETTY_FUNCTION__, __LINE__); \
+                                                            }
 /**
  * @brief Macro for @b stack_descriptor verification.
- * Return @b EINVAL from errno.h and prints err message to @b LOG_FILE if @b stack_descriptor is invalid.
+ * Reports error through @b stack_error() and returns @b EINVAL from errno.h if @b stack_descriptor is invalid.
  */
-#define STACK_DESCRIPTOR_VERIFICATION(stack_descriptor) if(stack_descriptor_validation(stack_descriptor)) \
-                                                        { \
-                                                            fprintf(LOG_FILE, "%s: In %s: error: Invalid stack descriptor.\n", __FILE__, __PRETTY_FUNCTION__); \
-                                                            \
-                                                            return EINVAL; \
-                                                        }
+#define STACK_DESCRIPTOR_VERIFICATION(context, stack_descriptor)    if(stack_descriptor_validation(context, stack_descriptor)) \
+                                                                    { \
+                                                                        return stack_error(context, stack_descriptor, EINVAL, __FILE__, __PRETTY_FUNCTION__, __LINE__); \
+                                                                    }
+/**
+ * @brief Macro for quarantine check. Returns @b EPERM from errno.h without any verification and logging.
+ */
+#define STACK_QUARANTINE_VERIFICATION(context, stack_descriptor)    if(stack_quarantined(context, stack_descriptor)) \
+                                                                    { \
+                                                                        return EPERM; \
+                                                                    }
+/**
+ * @brief Macro for verification of the @b Stack while the auditor thread is running, see @b stack_audited_validation().
+ * Reports error through @b stack_error() and returns @b err_code if @b Stack is destructed or @b data is corrupted.
+ */
+#define STACK_AUDITED_VERIFICATION(context, stack_descriptor, err_code) if(stack_audited_validation(context, stack_descriptor)) \
+                                                                        { \
+                                                                            return stack_error(context, stack_descriptor, err_code, __FILE__, __PRETTY_FUNCTION__, __LINE__); \
+                                                                        }
 /**
  * @brief Macro for @b Stack, stack @b data and @b stack_descriptror verification.
+ * While the auditor thread is running the rest of verification is left to it.
  */
-#define VERIFICATION(stack_descriptor, ...) STACK_DESCRIPTOR_VERIFICATION(stack_descriptor); \
-                                            STACK_VERIFICATION(stack_descriptor, __VA_ARGS__); \
-                                            STACK_DATA_VERIFICATION(stack_descriptor);
+#define VERIFICATION(context, stack_descriptor, err_code)   STACK_DESCRIPTOR_VERIFICATION(context, stack_descriptor); \
+                                                            STACK_QUARANTINE_VERIFICATION(context, stack_descriptor); \
+                                                            if(!stack_audited(context)) \
+                                                            { \
+                                                                STACK_VERIFICATION(context, stack_descriptor, err_code); \
+                                                                STACK_DATA_VERIFICATION(context, stack_descriptor); \
+                                                            } \
+                                                            else \
+                                                            { \
+                                                                STACK_AUDITED_VERIFICATION(context, stack_descriptor, err_code); \
+                                                            }
 #else
 
 #define STACK_VERIFICATION(...)
@@ -68,13 +91,15 @@ extern FILE *LOG_FILE; ///< Log file from log.cpp.
 
 #define STACK_DESCRIPTOR_VERIFICATION(...)
 
+#define STACK_QUARANTINE_VERIFICATION(...)
+
+#define STACK_AUDITED_VERIFICATION(...)
+
 #define VERIFICATION(...)
 
 #endif
 
-#ifdef PROTECT
-
-#include "hash_functions.h"
+#if STACK_HASH
 /**
  * @brief Macro for @b stack and it`s @b data hashing.
  */
@@ -86,82 +111,208 @@ extern FILE *LOG_FILE; ///< Log file from log.cpp.
 
 #endif
 
-#ifdef PROTECT
+#if STACK_THREAD_SAFE
 /**
- * @brief Macro for stack @b data expansion in @b times times.
- *
+ * @brief Macro for locking @b Stack until the end of the scope.
  */
-#define REALLOC_DATA_UP(stack_ptr, times) (elem_t *)((canary_t *)realloc(((canary_t *)stack_ptr->data) - 1, \
-                                           sizeof(elem_t) * (stack_ptr->capacity *= times) + 2 * sizeof(canary_t)) + 1)
+#define STACK_LOCK(stk_adr) std::lock_guard<Stack_lock> stack_guard(stk_adr->lock)
+#else
+
+#define STACK_LOCK(...)
+
+#endif
+
+#if STACK_CANARY && STACK_ALIGN
 /**
- * @brief Macro for stack @b data shrinking in @b times times.
-*/
-#define REALLOC_DATA_DOWN(stack_ptr, times) (elem_t *)((canary_t *)realloc(((canary_t *)stack_ptr->data) - 1, \
-                                             sizeof(elem_t) * (stack_ptr->capacity /= times) + 2 * sizeof(canary_t)) + 1)
+ * @brief Bytes before @b data in it`s allocation.
+ * Left data canary lies in the line before aligned @b data, right one - right after @b data.
+ */
+#define DATA_PREFIX STACK_ALIGN
+#define DATA_SUFFIX sizeof(canary_t)
+#elif STACK_CANARY
+
+#define DATA_PREFIX sizeof(canary_t)
+#define DATA_SUFFIX sizeof(canary_t)
+
 #else
 
-#define REALLOC_DATA_UP(stack_ptr, times) (elem_t *)realloc(stack_ptr->data, \
-                                           sizeof(elem_t) * (stack_ptr->capacity *= times))
+#define DATA_PREFIX 0
+#define DATA_SUFFIX 0
 
-#define REALLOC_DATA_DOWN(stack_ptr, times) (elem_t *)realloc(stack_ptr->data, \
-                                             sizeof(elem_t) * (stack_ptr->capacity /= times))
 #endif
+
+#if STACK_ALIGN
+/**
+ * @brief Size of the @b data allocation with given capacity. Multiple of @b STACK_ALIGN as aligned_alloc() requires.
+ */
+#define DATA_ALLOC_SIZE(capacity) ((DATA_PREFIX + sizeof(elem_t) * (capacity) + DATA_SUFFIX + STACK_ALIGN - 1) & ~(size_t)(STACK_ALIGN - 1))
+#else
+
+#define DATA_ALLOC_SIZE(capacity) (DATA_PREFIX + sizeof(elem_t) * (capacity) + DATA_SUFFIX)
+
+#endif
+/**
+ * @brief Max capacity for which @b DATA_ALLOC_SIZE() does not overflow.
+ */
+#define MAX_CAPACITY ((SIZE_MAX - DATA_PREFIX - DATA_SUFFIX - STACK_ALIGN) / sizeof(elem_t))
+/**
+ * @brief Converts @b data pointer to the pointer to it`s allocation and vice versa.
+ */
+#define DATA_TO_ALLOC(data_ptr)  ((void *)((char *)(data_ptr) - DATA_PREFIX))
+#define ALLOC_TO_DATA(alloc_ptr) ((elem_t *)((char *)(alloc_ptr) + DATA_PREFIX))
+
+/**
+ * @brief Macro for stack @b data expansion in @b times times.
+ * Returns pointer to the new allocation, capacity is not changed.
+ */
+#define REALLOC_DATA_UP(context, stack_ptr, times) data_realloc(context, DATA_TO_ALLOC(stack_ptr->data), DATA_ALLOC_SIZE(stack_ptr->capacity), \
+                                                                DATA_ALLOC_SIZE(stack_ptr->capacity * times))
+/**
+ * @brief Macro for stack @b data shrinking in @b times times.
+ * Returns pointer to the new allocation, capacity is not changed.
+ */
+#define REALLOC_DATA_DOWN(context, stack_ptr, times) data_realloc(context, DATA_TO_ALLOC(stack_ptr->data), DATA_ALLOC_SIZE(stack_ptr->capacity), \
+                                                                  DATA_ALLOC_SIZE(stack_ptr->capacity / times))
+
+/**
+ * @brief Operations for @b stack_reduce.
+ */
+enum Reduce_op
+{
+    REDUCE_SUM,
+    REDUCE_MIN,
+    REDUCE_MAX,
+};
+
+const size_t Default_max_stacks = 100; ///< Size of the descriptor table by default.
+
+/**
+ * @brief Allocator of stack @b data.
+ */
+struct Stack_allocator
+{
+    void *(*alloc)  (size_t alignment, size_t n_bytes); ///< Allocates @b n_bytes bytes aligned to @b alignment, 0 - any.
+    void  (*dealloc)(void *ptr);                        ///< Frees memory allocated by @b alloc.
+};
+
+/**
+ * @brief Configuration of the library context. Zero fields mean defaults.
+ */
+struct Stack_library_config
+{
+    size_t          max_stacks; ///< Size of the descriptor table, @b Default_max_stacks if 0.
+    const char     *log_path;   ///< Log-file opened on the first message, @b Default_log_path if @b NULL.
+                                ///< Should live as long as the context.
+    FILE           *log_file;   ///< Ready sink used instead of @b log_path. Not closed by the library.
+    Stack_allocator allocator;  ///< Allocator of stack @b data, aligned_alloc() and free() if @b NULL.
+};
+
+inline namespace STACK_ABI_NS
+{
+
+/**
+ * @brief Library context: descriptor table, log sink, allocator, error reporting and auditor. Contexts are independent,
+ * descriptors are valid only in the context they were created in.
+ */
+struct Stack_context;
+
+/**
+ * @brief Creates library context. Nothing is allocated or opened before this call, log-file is opened
+ * only when the first message is written.
+ * @param context_ptr Pointer to write created context to.
+ * @param config Configuration, @b NULL for defaults.
+ * @return int Error code.
+ */
+int stack_library_init(Stack_context **context_ptr, const Stack_library_config *config = NULL);
+
+/**
+ * @brief Destroys library context: stops it`s auditor, frees all it`s stacks and closes it`s log-file.
+ * @param context Library context.
+ * @return int Error code.
+ */
+int stack_library_destroy(Stack_context *context);
+
+/**
+ * @brief Returns default context, used by functions without @b context parameter. Created on the first call.
+ * @return Stack_context* Default context.
+ */
+Stack_context *stack_default_context(void);
+
 /**
  * @brief @b Stack constructor.
  * Generates @b Stack with given capacity and writes it`s descriptor to a @b stack_descriptor if succeded, otherwise @b 0;
+ * Descriptors are never reused, so descriptor of destructed @b Stack stays invalid.
+ * @param context Library context.
  * @param stack_descriptor Pointer to stack descriptor.
  * @param capacity Capacity of generated stack.
  * @return int Error code.
  */
-int stack_ctor(stk_d *stack_descriptor, const size_t capacity);
+int stack_ctor(Stack_context *context, stk_d *stack_descriptor, const size_t capacity);
 
 /**
  * @brief @b Stack destructor.
+ * @param context Library context.
  * @param stack_descriptor Stack descriptor.
  * @return int Error code.
  */
-int stack_dtor(const stk_d stack_descriptor);
+int stack_dtor(Stack_context *context, const stk_d stack_descriptor);
 
 /**
  * @brief Function for pushing elements ito the stack.
+ * @param context Library context.
  * @param stack_descriptor Stack descriptor.
  * @param val Element value to push.
  * @return int Error code.
  */
-int push_stack(const stk_d stack_descriptor, const elem_t val);
+int push_stack(Stack_context *context, const stk_d stack_descriptor, const elem_t val);
 
 /**
  * @brief Function for removing elements from the stack.
+ * @param context Library context.
  * @param stack_descriptor Stack descriptor.
  * @param ret_val If not @b NULL, writes removed value to @b ret_val.
  * @return int Error code.
  */
-int pop_stack(const stk_d stack_descriptor, elem_t *ret_val = NULL);
+int pop_stack(Stack_context *context, const stk_d stack_descriptor, elem_t *ret_val = NULL);
 
 /**
  * @brief Function for @b Stack data expansion, if needed more space.
+ * @param context Library context.
  * @param stack_descriptor Stack descriptor.
  * @return int Error code.
  */
-int optimal_expansion(const stk_d stack_descriptor);
+int optimal_expansion(Stack_context *context, const stk_d stack_descriptor);
 
 /**
  * @brief Function for @b Stack data expansion, if there is too much free space.
+ * @param context Library context.
  * @param stack_descriptor Stack descriptor.
  * @return int Error code.
  */
-int optimal_shrink(const stk_d stack_descriptor);
+int optimal_shrink(Stack_context *context, const stk_d stack_descriptor);
+
+/**
+ * @brief Function for @b Stack data expansion, so that @b n_elems more elements fit without reallocation.
+ * Capacity grows by the growth factor as many times as needed, but not above @b MAX_CAPACITY.
+ * @param context Library context.
+ * @param stack_descriptor Stack descriptor.
+ * @param n_elems Number of elements to fit.
+ * @return int Error code. @b ENOMEM if @b n_elems more elements can`t fit in @b MAX_CAPACITY.
+ */
+int stack_reserve(Stack_context *context, const stk_d stack_descriptor, const size_t n_elems);
 
 /**
  * @brief Function that clears @b stack and fills it with @b 0.
+ * @param context Library context.
  * @param stack_descriptor Stack descriptor.
  * @return int Error code.
  */
-int clear_stack(const stk_d stack_descriptor);
+int clear_stack(Stack_context *context, const stk_d stack_descriptor);
 
 /**
  * @brief
  *
+ * @param context Library context.
  * @param stack_descriptor Stack descriptor.
  * @param stack_name Name of the @b Stack given.
  * @param file_name Name of the file from which function was called.
@@ -169,35 +320,264 @@ int clear_stack(const stk_d stack_descriptor);
  * @param line Number of line where function was called.
  * @return int Error code.
  */
-int stack_dump(const stk_d stack_descriptor, const char *stack_name, const char *file_name, const char * func_declaration, const int line);
+int stack_dump(Stack_context *context, const stk_d stack_descriptor, const char *stack_name, const char *file_name, const char * func_declaration, const int line);
 
 /**
  * @brief Function that returns copy of @b stack without @b data
+ * @param context Library context.
  * @param stack_descriptor Stack descriptor.
  * @return struct Stack @b copy of @b stack.
  */
-struct Stack stack_info(const stk_d stack_descriptor);
+struct Stack stack_info(Stack_context *context, const stk_d stack_descriptor);
 
-#ifdef PROTECT
 /**
- * @brief Macro for @b stack_descriptor verification.
+ * @brief Function that finds first element equal to @b val in @b stack. @b Stack is verified once per call.
+ * @param context Library context.
+ * @param stack_descriptor Stack descriptor.
+ * @param val Value to find.
+ * @param index Index of found element from the bottom of the @b stack.
+ * @return int Error code. @b ENOENT if there is no such element.
+ */
+int stack_find(Stack_context *context, const stk_d stack_descriptor, const elem_t val, size_t *index);
+
+/**
+ * @brief Function that counts elements equal to @b val in @b stack. @b Stack is verified once per call.
+ * @param context Library context.
+ * @param stack_descriptor Stack descriptor.
+ * @param val Value to count.
+ * @param count Number of found elements.
+ * @return int Error code.
+ */
+int stack_count(Stack_context *context, const stk_d stack_descriptor, const elem_t val, size_t *count);
+
+/**
+ * @brief Function that reduces @b stack elements with @b op. @b Stack is verified once per call.
+ * Sum wraps around on overflow and is @b 0 for empty @b stack.
+ * @param context Library context.
+ * @param stack_descriptor Stack descriptor.
+ * @param op Reduce operation.
+ * @param result Result of reduction.
+ * @return int Error code. @b EINVAL for min or max of empty @b stack.
+ */
+int stack_reduce(Stack_context *context, const stk_d stack_descriptor, const Reduce_op op, elem_t *result);
+
+/**
+ * @brief Function that returns read-only view of @b stack elements without copying.
+ * View is valid until next modification of the @b stack.
+ * @param context Library context.
+ * @param stack_descriptor Stack descriptor.
+ * @return std::span<const elem_t> Elements from the bottom to the top, empty if @b stack is invalid.
+ */
+std::span<const elem_t> stack_view(Stack_context *context, const stk_d stack_descriptor);
+
+/**
+ * @brief Function that returns pointer to the @b stack itself, bypassing verification and locking.
+ * Meant for diagnostics and fault injection only.
+ * @param context Library context.
+ * @param stack_descriptor Stack descriptor.
+ * @return struct Stack* Pointer to the @b stack or @b NULL if @b stack_descriptor is invalid.
+ */
+struct Stack *stack_raw(Stack_context *context, const stk_d stack_descriptor);
+
+/**
+ * @brief Function that reports error of the @b stack through @b report_stack_error() with error reporter of the @b context.
+ * Quarantines the @b stack if error handler asks to.
+ * @param context Library context.
+ * @param stack_descriptor Stack descriptor.
+ * @param err_code Error code.
+ * @param file Call site file.
+ * @param func Call site function.
+ * @param line Call site line.
+ * @return int @b err_code.
+ */
+int stack_error(Stack_context *context, const stk_d stack_descriptor, const int err_code, const char *file, const char *func, const int line);
+
+/**
+ * @brief Sets error handler of the @b context. @b NULL restores default handler, which only logs.
+ * @param context Library context.
+ * @param handler New error handler.
+ */
+void stack_error_handler(Stack_context *context, error_handler_t handler);
+
+/**
+ * @brief Sets max number of error records written to log-file of the @b context per second.
+ * @param context Library context.
+ * @param max_per_second Max number of records, @b 0 disables logging of records and summaries of dropped ones.
+ */
+void stack_error_rate_limit(Stack_context *context, const size_t max_per_second);
+
+/**
+ * @brief Function that checks if the @b stack is quarantined.
+ * @param context Library context.
+ * @param stack_descriptor Stack descriptor.
+ * @return int Non-zero if the @b stack is quarantined.
+ */
+int stack_quarantined(Stack_context *context, const stk_d stack_descriptor);
+
+/**
+ * @brief Function that checks if the auditor thread is running, so that operations skip hash verification.
+ * @param context Library context.
+ * @return int Non-zero if the auditor is running.
+ */
+int stack_audited(Stack_context *context);
+
+/**
+ * @brief Function for @b stack verification while the auditor thread is running.
+ * Checks that @b stack is not destructed, the rest is verified by the auditor.
+ * @param context Library context.
+ * @param stack_descriptor Stack descriptor.
+ * @return int Non-zero if @b stack is invalid.
+ */
+int stack_audited_validation(Stack_context *context, const stk_d stack_descriptor);
+
+/**
+ * @brief Function for @b stack_descriptor verification.
+ * @param context Library context.
  * @param stack_descriptor Stack descriptor.
  * @return int Err code.
  */
-int stack_descriptor_validation(const stk_d stack_descriptor);
+int stack_descriptor_validation(Stack_context *context, const stk_d stack_descriptor);
 
 /**
- * @brief Macro for @b stack verification. Fills @b err bit-field.
+ * @brief Function for @b stack verification. Fills @b err bit-field.
+ * @param context Library context.
  * @param stack_descriptor Stack descriptor.
+ * @return int Non-zero if @b stack is invalid.
  */
-void stack_validation(const stk_d stack_descriptor);
+int stack_validation(Stack_context *context, const stk_d stack_descriptor);
 
 /**
- * @brief Macro for @b stack verification. Fills @b err bit-field.
+ * @brief Function for @b stack data verification. Sets @b invalid bit of @b err bit-field if data is corrupted.
+ * @param context Library context.
  * @param stack_descriptor Stack descriptor.
+ * @return int Non-zero if @b stack data is corrupted. Errors left in @b err by earlier operations are not counted.
  */
-void stack_data_validation(const stk_d stack_descriptor);
+int stack_data_validation(Stack_context *context, const stk_d stack_descriptor);
 
-#endif
+/*
+ * Functions without @b context work in @b stack_default_context().
+ */
+
+inline int stack_ctor(stk_d *stack_descriptor, const size_t capacity)
+{
+    return stack_ctor(stack_default_context(), stack_descriptor, capacity);
+}
+
+inline int stack_dtor(const stk_d stack_descriptor)
+{
+    return stack_dtor(stack_default_context(), stack_descriptor);
+}
+
+inline int push_stack(const stk_d stack_descriptor, const elem_t val)
+{
+    return push_stack(stack_default_context(), stack_descriptor, val);
+}
+
+inline int pop_stack(const stk_d stack_descriptor, elem_t *ret_val = NULL)
+{
+    return pop_stack(stack_default_context(), stack_descriptor, ret_val);
+}
+
+inline int optimal_expansion(const stk_d stack_descriptor)
+{
+    return optimal_expansion(stack_default_context(), stack_descriptor);
+}
+
+inline int optimal_shrink(const stk_d stack_descriptor)
+{
+    return optimal_shrink(stack_default_context(), stack_descriptor);
+}
+
+inline int stack_reserve(const stk_d stack_descriptor, const size_t n_elems)
+{
+    return stack_reserve(stack_default_context(), stack_descriptor, n_elems);
+}
+
+inline int clear_stack(const stk_d stack_descriptor)
+{
+    return clear_stack(stack_default_context(), stack_descriptor);
+}
+
+inline int stack_dump(const stk_d stack_descriptor, const char *stack_name, const char *file_name, const char *func_declaration, const int line)
+{
+    return stack_dump(stack_default_context(), stack_descriptor, stack_name, file_name, func_declaration, line);
+}
+
+inline struct Stack stack_info(const stk_d stack_descriptor)
+{
+    return stack_info(stack_default_context(), stack_descriptor);
+}
+
+inline int stack_find(const stk_d stack_descriptor, const elem_t val, size_t *index)
+{
+    return stack_find(stack_default_context(), stack_descriptor, val, index);
+}
+
+inline int stack_count(const stk_d stack_descriptor, const elem_t val, size_t *count)
+{
+    return stack_count(stack_default_context(), stack_descriptor, val, count);
+}
+
+inline int stack_reduce(const stk_d stack_descriptor, const Reduce_op op, elem_t *result)
+{
+    return stack_reduce(stack_default_context(), stack_descriptor, op, result);
+}
+
+inline std::span<const elem_t> stack_view(const stk_d stack_descriptor)
+{
+    return stack_view(stack_default_context(), stack_descriptor);
+}
+
+inline struct Stack *stack_raw(const stk_d stack_descriptor)
+{
+    return stack_raw(stack_default_context(), stack_descriptor);
+}
+
+inline int stack_error(const stk_d stack_descriptor, const int err_code, const char *file, const char *func, const int line)
+{
+    return stack_error(stack_default_context(), stack_descriptor, err_code, file, func, line);
+}
+
+inline void stack_error_handler(error_handler_t handler)
+{
+    stack_error_handler(stack_default_context(), handler);
+}
+
+inline void stack_error_rate_limit(const size_t max_per_second)
+{
+    stack_error_rate_limit(stack_default_context(), max_per_second);
+}
+
+inline int stack_quarantined(const stk_d stack_descriptor)
+{
+    return stack_quarantined(stack_default_context(), stack_descriptor);
+}
+
+inline int stack_audited(void)
+{
+    return stack_audited(stack_default_context());
+}
+
+inline int stack_audited_validation(const stk_d stack_descriptor)
+{
+    return stack_audited_validation(stack_default_context(), stack_descriptor);
+}
+
+inline int stack_descriptor_validation(const stk_d stack_descriptor)
+{
+    return stack_descriptor_validation(stack_default_context(), stack_descriptor);
+}
+
+inline int stack_validation(const stk_d stack_descriptor)
+{
+    return stack_validation(stack_default_context(), stack_descriptor);
+}
+
+inline int stack_data_validation(const stk_d stack_descriptor)
+{
+    return stack_data_validation(stack_default_context(), stack_descriptor);
+}
+
+}
 
 #endif //STACK_H
@@ -0,0 +1,77 @@
+#ifndef STACK_AUDIT_H
+#define STACK_AUDIT_H
+
+/**
+ * @file stack_audit.h
+ * @author GraY
+ * @brief Background auditor thread that verifies stacks instead of every operation.
+ *
+ * While the auditor is running, operations only update hashes and check descriptor, quarantine and that
+ * the @b Stack is not destructed. The auditor walks the descriptor table, fully verifies every @b Stack under
+ * it`s lock and reports corrupted stacks through the error handler, which may quarantine them. Busy stacks are
+ * skipped till the next pass. The auditor thread needs @b STACK_THREAD_SAFE: without locks @b data may be freed
+ * while the auditor reads it.
+ */
+
+#include "stack.h"
+
+/**
+ * @brief Cadence and CPU budget of the auditor.
+ */
+struct Audit_config
+{
+    unsigned int period_ms;      ///< Auditor wakes up every @b period_ms milliseconds.
+    unsigned int budget_percent; ///< Part of the period the auditor may spend on verification, from 1 to 100.
+};
+
+const Audit_config Default_audit_config = {10, 5}; ///< 0.5 ms of verification every 10 ms.
+
+inline namespace STACK_ABI_NS
+{
+
+/**
+ * @brief Starts the auditor thread of the @b context. Stacks which do not fit in the budget are verified on the next wake-ups.
+ * @param context Library context.
+ * @param config Cadence and CPU budget, @b NULL for @b Default_audit_config.
+ * @return int Error code. @b EALREADY if the auditor is running, @b ENOTSUP without protection policies
+ * or @b STACK_THREAD_SAFE.
+ */
+int stack_audit_start(Stack_context *context, const Audit_config *config = NULL);
+
+/**
+ * @brief Stops the auditor thread of the @b context, operations verify stacks again.
+ * @param context Library context.
+ * @return int Error code. @b ESRCH if the auditor is not running.
+ */
+int stack_audit_stop(Stack_context *context);
+
+/**
+ * @brief Verifies every @b Stack of the @b context once in the calling thread, the same way the auditor does.
+ * Unlike the auditor thread, works without @b STACK_THREAD_SAFE.
+ * @param context Library context.
+ * @return size_t Number of corrupted stacks found.
+ */
+size_t stack_audit_pass(Stack_context *context);
+
+/*
+ * Functions without @b context work in @b stack_default_context().
+ */
+
+inline int stack_audit_start(const Audit_config *config = NULL)
+{
+    return stack_audit_start(stack_default_context(), config);
+}
+
+inline int stack_audit_stop(void)
+{
+    return stack_audit_stop(stack_default_context());
+}
+
+inline size_t stack_audit_pass(void)
+{
+    return stack_audit_pass(stack_default_context());
+}
+
+}
+
+#endif //STACK_AUDIT_H
@@ -0,0 +1,75 @@
+#ifndef STACK_CONTEXT_H
+#define STACK_CONTEXT_H
+
+/**
+ * @file stack_context.h
+ * @author GraY
+ * @brief Layout of the library context. Used by library sources, users work with the context through pointers.
+ */
+
+#include <stddef.h>
+#include <stdio.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "stack.h"
+
+inline namespace STACK_ABI_NS
+{
+
+struct Stack_context
+{
+    struct Stack           *stacks            = NULL; ///< Descriptor table.
+    size_t                  max_stacks        = 0;   ///< Size of the descriptor table.
+    std::atomic<size_t>     n_buffered_stacks = 1;   ///< Descriptors below are in use or were used.
+    std::mutex              registry_lock     = {};  ///< Guards the descriptor table if @b STACK_THREAD_SAFE.
+
+    Stack_allocator         allocator         = {};  ///< Allocator of stack @b data.
+
+    const char             *log_path          = NULL; ///< Log-file opened on the first message.
+    FILE                   *log               = NULL; ///< Sink, @b NULL until the first message.
+    bool                    own_log           = false; ///< Sink is opened by the context and closed with it.
+    std::once_flag          log_once          = {};  ///< Opens @b log_path once.
+
+    std::atomic<bool>       audit_running     = false; ///< Operations skip hash verification.
+    std::thread             auditor           = {};  ///< Auditor thread.
+    std::mutex              audit_lock        = {};  ///< Guards @b auditor and @b audit_stop.
+    std::condition_variable audit_wake        = {};  ///< Wakes auditor up to stop.
+    bool                    audit_stop        = false; ///< Auditor should stop.
+
+    Error_reporter          reporter          = {};  ///< Error handler, deduplication and rate limit.
+};
+
+/**
+ * @brief Returns log sink of the @b context, opening it on the first call.
+ * @param context Library context.
+ * @return FILE* Log-file.
+ */
+FILE *stack_log_file(Stack_context *context);
+
+/**
+ * @brief Reports error of the @b Stack like @b stack_error(), but tells if the record was written to log-file,
+ * so that the auditor dumps the @b Stack only together with a written record.
+ * @param context Library context.
+ * @param stack_descriptor Stack descriptor.
+ * @param err_code Error code.
+ * @param file Call site file.
+ * @param func Call site function.
+ * @param line Call site line.
+ * @return bool True if the record is written, false if it is suppressed as a duplicate or by the rate limit.
+ */
+bool stack_error_logged(Stack_context *context, const stk_d stack_descriptor, const int err_code,
+                        const char *file, const char *func, const int line);
+
+}
+
+/**
+ * @brief Library sources log into the sink of the @b context of the function.
+ */
+#undef  LOG_FILE
+#define LOG_FILE stack_log_file(context)
+
+#endif //STACK_CONTEXT_H
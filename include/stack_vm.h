@@ -0,0 +1,75 @@
+#ifndef STACK_VM_H
+#define STACK_VM_H
+
+/**
+ * @file stack_vm.h
+ * @author GraY
+ * @brief Bytecode evaluator that uses @b Stack as it`s operand stack.
+ *
+ * Code is split into basic blocks by jumps. @b Stack is verified and reserved once at the start of every block
+ * and hashed once at it`s end, instructions inside the block work with @b data directly.
+ */
+
+#include <stddef.h>
+
+#include "stack.h"
+#include "types.h"
+
+/**
+ * @brief Instructions of the evaluator. Binary operations pop @b b, then @b a and push @b a op @b b.
+ * Arithmetic wraps around on overflow.
+ */
+enum Vm_op
+{
+    VM_HALT, ///< Stop evaluation.
+    VM_PUSH, ///< Push @b arg.
+    VM_POP,  ///< Remove top element.
+    VM_DUP,  ///< Duplicate top element.
+    VM_SWAP, ///< Swap two top elements.
+    VM_OVER, ///< Push copy of the element under the top one.
+    VM_ADD,  ///< a + b.
+    VM_SUB,  ///< a - b.
+    VM_MUL,  ///< a * b.
+    VM_DIV,  ///< a / b. @b EDOM if b is 0.
+    VM_MOD,  ///< a % b. @b EDOM if b is 0.
+    VM_NEG,  ///< Negate top element.
+    VM_JMP,  ///< Jump to instruction @b arg.
+    VM_JZ,   ///< Pop element, jump to instruction @b arg if it is 0.
+    VM_JNZ,  ///< Pop element, jump to instruction @b arg if it is not 0.
+};
+
+/**
+ * @brief Instruction of the evaluator.
+ */
+struct Vm_instr
+{
+    Vm_op  op;  ///< Operation.
+    elem_t arg; ///< Argument of @b VM_PUSH and jumps.
+};
+
+inline namespace STACK_ABI_NS
+{
+
+/**
+ * @brief Function that runs @b code on the @b stack until @b VM_HALT or the end of the @b code.
+ * On error instructions executed before it stay applied.
+ * @param context Library context.
+ * @param stack_descriptor Stack descriptor.
+ * @param code Instructions.
+ * @param n_instrs Number of instructions.
+ * @return int Error code. @b ERANGE on operand stack underflow, @b EDOM on division by zero,
+ * @b ENOEXEC on unknown instruction or jump outside the @b code.
+ */
+int stack_vm_run(Stack_context *context, const stk_d stack_descriptor, const Vm_instr *code, const size_t n_instrs);
+
+/**
+ * @brief Same as above in @b stack_default_context().
+ */
+inline int stack_vm_run(const stk_d stack_descriptor, const Vm_instr *code, const size_t n_instrs)
+{
+    return stack_vm_run(stack_default_context(), stack_descriptor, code, n_instrs);
+}
+
+}
+
+#endif //STACK_VM_H
@@ -1,8 +1,6 @@
 #ifndef TYPES_H
 #define TYPES_H
 
-#define PROTECT
-
 /**
  * @file types.h
  * @author GraY
@@ -11,15 +9,28 @@
 
 #include <stddef.h>
 
+#include "config.h"
+
+#if STACK_THREAD_SAFE
+#include <mutex>
+#endif
+
+#if STACK_ALIGN
+#define STACK_ALIGNAS alignas(STACK_ALIGN)
+#else
+#define STACK_ALIGNAS
+#endif
+
 typedef size_t stk_d;                ///< Type define for @b stack descriptor.
 typedef long long elem_t;            ///< Type define for elements of @b Stack data.
 #define ETS "%lld"
 
-#ifdef PROTECT
-
 typedef unsigned long long canary_t; ///< Type define for @b Canary value.
 const canary_t Canary_val = 0xB1BAB0BA; ///< Canary value for canary protection.
 
+inline namespace STACK_ABI_NS
+{
+
 /**
  * @brief Errors bit-field.
  * Shows errors in @b Stack structure.
@@ -33,30 +44,66 @@ struct Err
     unsigned int underflow:1;
 };
 
+#if STACK_THREAD_SAFE
+/**
+ * @brief Recursive lock of the @b Stack.
+ * Copy of the lock is always unlocked, so @b Stack stays copyable.
+ */
+class Stack_lock
+{
+    public:
+        Stack_lock(void): mutex() {}
+        Stack_lock(const Stack_lock &): mutex() {}
+        Stack_lock &operator=(const Stack_lock &) { return *this; }
+
+        void lock    (void) { mutex.lock();   }
+        void unlock  (void) { mutex.unlock(); }
+        bool try_lock(void) { return mutex.try_lock(); }
+
+    private:
+        std::recursive_mutex mutex;
+};
 #endif
 
 /**
  * @brief Stack structure.
+ * Fields used by every operation go first, protection fields go after them.
+ * With @b STACK_ALIGN every @b Stack starts at it`s own cache line, so neighbour stacks in the descriptor table
+ * are not falsely shared between threads.
  */
-struct Stack
+struct STACK_ALIGNAS Stack
 {
-    #ifdef PROTECT
-    canary_t canary_left;  ///< Left @b Canary for canary protection.
-    #endif
-
     size_t size;           ///< Number of elements in @b Stack data.
     size_t capacity;       ///< Number of max amount of elements in @b Stack data.
 
     elem_t *data;          ///< @b Stack data.
 
-    #ifdef PROTECT
+    #if STACK_CANARY
+    canary_t canary_left;  ///< Left @b Canary for canary protection.
+    #endif
+
+    #if STACK_HASH
     size_t stack_hash;     ///< Hashed @b Stack value.
     size_t data_hash;      ///< Hashed @b Stack data.
+    #endif
 
-    struct Err err;        ///< Errors bit-field.
+    #if STACK_PROTECT
+    struct Err err;        ///< Errors bit-field. Not hashed, every verification fills it anew.
+    #endif
 
+    #if STACK_CANARY
     canary_t canary_right; ///< Right @b Canary for canary protection.
     #endif
+
+    #if STACK_PROTECT
+    bool quarantined;      ///< Set by error handler, all operations except destruction are refused. Not hashed, atomic.
+    #endif
+
+    #if STACK_THREAD_SAFE
+    Stack_lock lock;       ///< Lock of the @b Stack. Not hashed.
+    #endif
 };
 
+}
+
 #endif //TYPES_H
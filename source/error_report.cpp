@@ -0,0 +1,162 @@
+/**
+ * @file error_report.cpp
+ * @author GraY
+ * @brief Error reporting definitions.
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <chrono>
+#include <mutex>
+
+#include "../include/error_report.h"
+#include "../include/log.h"
+
+#undef  LOG_FILE
+#define LOG_FILE sink
+
+static const long long Ms_per_second = 1000;
+
+static long long now_ms(void)
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static bool same_key(const Dedup_slot *slot, const Stack_error *error)
+{
+    return slot->used && slot->descriptor == error->descriptor && slot->err_code == error->err_code &&
+           slot->err_bits == error->err_bits && slot->file == error->file && slot->line == error->line;
+}
+
+static Dedup_slot *dedup_slot(Error_reporter *reporter, const Stack_error *error)
+{
+    size_t key = error->descriptor * 31 + (size_t)error->line * 17 + error->err_bits;
+
+    return reporter->dedup_table + key % Error_dedup_slots;
+}
+
+/**
+ * @brief Writes summary of dropped records if there are any. Called under the lock of the @b reporter.
+ */
+static void log_dropped(Error_reporter *reporter, [[maybe_unused]] FILE *sink)
+{
+    if(reporter->n_dropped)
+    {
+        LOG("stack_error: dropped = %zu\n", reporter->n_dropped);
+    }
+
+    reporter->n_dropped = 0;
+}
+
+/**
+ * @brief Checks rate limit and counts the record if it fits.
+ * Zero limit turns logging of records off, so nothing is counted as dropped and no summary is written.
+ */
+static bool rate_limit_pass(Error_reporter *reporter, const long long now, FILE *sink)
+{
+    if(reporter->reports_per_second == 0) return false;
+
+    if(now - reporter->rate_window_start >= Ms_per_second)
+    {
+        log_dropped(reporter, sink);
+
+        reporter->rate_window_start   = now;
+        reporter->n_reports_in_window = 0;
+    }
+
+    if(reporter->n_reports_in_window >= reporter->reports_per_second)
+    {
+        reporter->n_dropped++;
+
+        return false;
+    }
+
+    reporter->n_reports_in_window++;
+
+    return true;
+}
+
+void error_reporter_handler(Error_reporter *reporter, error_handler_t handler)
+{
+    assert(reporter);
+
+    std::lock_guard<std::mutex> guard(reporter->lock);
+
+    reporter->handler = handler;
+}
+
+void error_reporter_rate_limit(Error_reporter *reporter, const size_t max_per_second)
+{
+    assert(reporter);
+
+    std::lock_guard<std::mutex> guard(reporter->lock);
+
+    reporter->reports_per_second = max_per_second;
+
+    if(max_per_second == 0) reporter->n_dropped = 0;
+}
+
+Error_action report_stack_error(Error_reporter *reporter, Stack_error *error, FILE *sink)
+{
+    assert(reporter);
+    assert(error);
+    assert(sink);
+
+    error_handler_t handler = NULL;
+
+    error->logged = false;
+
+    {
+        std::lock_guard<std::mutex> guard(reporter->lock);
+
+        long long now = now_ms();
+
+        Dedup_slot *slot = dedup_slot(reporter, error);
+
+        if(same_key(slot, error) && now - slot->last_report_ms < (long long)Error_dedup_window_ms)
+        {
+            slot->n_suppressed++;
+
+            return ERROR_LOG;
+        }
+
+        error->n_repeats = same_key(slot, error) ? slot->n_suppressed : 0;
+
+        *slot = {true, error->descriptor, error->err_code, error->err_bits, error->file, error->line, now, 0};
+
+        handler       = reporter->handler;
+        error->logged = rate_limit_pass(reporter, now, sink);
+    }
+
+    Error_action action = handler ? handler(error) : ERROR_LOG;
+
+    if(error->logged)
+    {
+        LOG("stack_error: descriptor = %zu, code = %d, err = %#x, stack_hash = %zu, data_hash = %zu, "
+            "site = %s:%d, function = \"%s\", repeats = %zu\n",
+            error->descriptor, error->err_code, error->err_bits, error->stack_hash, error->data_hash,
+            error->file, error->line, error->func, error->n_repeats);
+    }
+
+    if(action == ERROR_ABORT)
+    {
+        LOGS("stack_error: aborting\n");
+        fflush(LOG_FILE);
+
+        abort();
+    }
+
+    return action;
+}
+
+void report_stack_error_flush(Error_reporter *reporter, FILE *sink)
+{
+    assert(reporter);
+    assert(sink);
+
+    std::lock_guard<std::mutex> guard(reporter->lock);
+
+    log_dropped(reporter, sink);
+}
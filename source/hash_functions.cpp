@@ -11,9 +11,26 @@
 
 static const unsigned long long P = 257;
 
-#ifdef PROTECT
+#if STACK_HASH
 
-size_t poly_hash_data(Stack *stack) //bad hash
+/**
+ * @brief Continues polynomial hash @b hash with @b n_bytes bytes from @b src.
+ */
+static void poly_hash_bytes(const void *src, const size_t n_bytes, size_t *hash, size_t *powered_P)
+{
+    for(size_t i = 0; i < n_bytes; i++)
+    {
+        *hash      += (size_t)((const char *)src)[i] * *powered_P;
+        *powered_P *= P;
+    }
+}
+
+#define POLY_HASH_FIELD(field) poly_hash_bytes(&stack->field, sizeof(stack->field), &hash_val, &powered_P)
+
+inline namespace STACK_ABI_NS
+{
+
+size_t poly_hash_data(const Stack *stack) //bad hash
 {
     assert(stack != NULL);
 
@@ -25,34 +42,36 @@ size_t poly_hash_data(Stack *stack) //bad hash
     size_t hash      = 0;
     size_t powered_P = 1;
 
-    for(size_t i = 0; i < stack->capacity * sizeof(elem_t); i++)
-    {
-        hash      += (size_t)((char *)stack->data)[i] * powered_P;
-        powered_P *= P;
-    }
+    poly_hash_bytes(stack->data, stack->capacity * sizeof(elem_t), &hash, &powered_P);
 
     return hash;
 }
 
-size_t poly_hash_stack(Stack *stack)
+size_t poly_hash_stack(const Stack *stack)
 {
     assert(stack != NULL);
 
-    size_t hash_prev  = stack->stack_hash;
-    stack->stack_hash = 0;
-
     size_t hash_val  = 0;
     size_t powered_P = 1;
 
-    for(size_t i = 0; i < sizeof(Stack); i++)
-    {
-        hash_val  += (size_t)((char *)stack)[i] * powered_P;
-        powered_P *= P;
-    }
+#if STACK_CANARY
+    POLY_HASH_FIELD(canary_left);
+#endif
 
-    stack->stack_hash = hash_prev;
+    POLY_HASH_FIELD(size);
+    POLY_HASH_FIELD(capacity);
+    POLY_HASH_FIELD(data);
+    POLY_HASH_FIELD(data_hash);
+
+#if STACK_CANARY
+    POLY_HASH_FIELD(canary_right);
+#endif
 
     return hash_val;
 }
 
-#endif
\ No newline at end of file
+}
+
+#undef POLY_HASH_FIELD
+
+#endif
@@ -0,0 +1,268 @@
+/**
+ * @file kernels.cpp
+ * @author GraY
+ * @brief SIMD kernels definitions and runtime dispatch.
+ */
+
+#include <assert.h>
+#include <stddef.h>
+
+#include "../include/kernels.h"
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#define KERNELS_X86
+#endif
+
+/**
+ * @brief Set of kernels for one instruction set.
+ */
+struct Kernels
+{
+    size_t (*find) (const elem_t *, const size_t, const elem_t);
+    size_t (*count)(const elem_t *, const size_t, const elem_t);
+    elem_t (*sum)  (const elem_t *, const size_t);
+    elem_t (*min)  (const elem_t *, const size_t);
+    elem_t (*max)  (const elem_t *, const size_t);
+};
+
+static size_t find_scalar(const elem_t *data, const size_t n_elems, const elem_t val)
+{
+    for(size_t i = 0; i < n_elems; i++)
+    {
+        if(data[i] == val) return i;
+    }
+
+    return n_elems;
+}
+
+static size_t count_scalar(const elem_t *data, const size_t n_elems, const elem_t val)
+{
+    size_t count = 0;
+
+    for(size_t i = 0; i < n_elems; i++)
+    {
+        count += (data[i] == val);
+    }
+
+    return count;
+}
+
+static elem_t sum_scalar(const elem_t *data, const size_t n_elems)
+{
+    unsigned long long sum = 0;
+
+    for(size_t i = 0; i < n_elems; i++)
+    {
+        sum += (unsigned long long)data[i];
+    }
+
+    return (elem_t)sum;
+}
+
+static elem_t min_scalar(const elem_t *data, const size_t n_elems)
+{
+    elem_t min = data[0];
+
+    for(size_t i = 1; i < n_elems; i++)
+    {
+        if(data[i] < min) min = data[i];
+    }
+
+    return min;
+}
+
+static elem_t max_scalar(const elem_t *data, const size_t n_elems)
+{
+    elem_t max = data[0];
+
+    for(size_t i = 1; i < n_elems; i++)
+    {
+        if(data[i] > max) max = data[i];
+    }
+
+    return max;
+}
+
+#ifdef KERNELS_X86
+
+static_assert(sizeof(elem_t) == sizeof(long long), "AVX2 kernels are written for 64-bit integer elements.");
+
+static const size_t Avx2_width = sizeof(__m256i) / sizeof(elem_t); ///< Elements in one AVX2 register.
+
+#define LOAD_AVX2(ptr) _mm256_loadu_si256((const __m256i *)(ptr))
+
+__attribute__((target("avx2")))
+static size_t find_avx2(const elem_t *data, const size_t n_elems, const elem_t val)
+{
+    const __m256i pattern = _mm256_set1_epi64x(val);
+
+    size_t i = 0;
+    for(; i + Avx2_width <= n_elems; i += Avx2_width)
+    {
+        int mask = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(LOAD_AVX2(data + i), pattern)));
+
+        if(mask) return i + (size_t)__builtin_ctz((unsigned int)mask);
+    }
+
+    return i + find_scalar(data + i, n_elems - i, val);
+}
+
+__attribute__((target("avx2")))
+static size_t count_avx2(const elem_t *data, const size_t n_elems, const elem_t val)
+{
+    const __m256i pattern = _mm256_set1_epi64x(val);
+    __m256i       counts  = _mm256_setzero_si256();
+
+    size_t i = 0;
+    for(; i + Avx2_width <= n_elems; i += Avx2_width)
+    {
+        counts = _mm256_sub_epi64(counts, _mm256_cmpeq_epi64(LOAD_AVX2(data + i), pattern));
+    }
+
+    long long lanes[Avx2_width] = {};
+    _mm256_storeu_si256((__m256i *)lanes, counts);
+
+    return (size_t)(lanes[0] + lanes[1] + lanes[2] + lanes[3]) + count_scalar(data + i, n_elems - i, val);
+}
+
+__attribute__((target("avx2")))
+static elem_t sum_avx2(const elem_t *data, const size_t n_elems)
+{
+    __m256i sums = _mm256_setzero_si256();
+
+    size_t i = 0;
+    for(; i + Avx2_width <= n_elems; i += Avx2_width)
+    {
+        sums = _mm256_add_epi64(sums, LOAD_AVX2(data + i));
+    }
+
+    unsigned long long lanes[Avx2_width] = {};
+    _mm256_storeu_si256((__m256i *)lanes, sums);
+
+    return (elem_t)(lanes[0] + lanes[1] + lanes[2] + lanes[3] + (unsigned long long)sum_scalar(data + i, n_elems - i));
+}
+
+__attribute__((target("avx2")))
+static elem_t min_avx2(const elem_t *data, const size_t n_elems)
+{
+    if(n_elems < Avx2_width) return min_scalar(data, n_elems);
+
+    __m256i mins = LOAD_AVX2(data);
+
+    size_t i = Avx2_width;
+    for(; i + Avx2_width <= n_elems; i += Avx2_width)
+    {
+        __m256i vals = LOAD_AVX2(data + i);
+        mins = _mm256_blendv_epi8(mins, vals, _mm256_cmpgt_epi64(mins, vals));
+    }
+
+    elem_t lanes[Avx2_width] = {};
+    _mm256_storeu_si256((__m256i *)lanes, mins);
+
+    elem_t min = min_scalar(lanes, Avx2_width);
+    if(i < n_elems)
+    {
+        elem_t tail_min = min_scalar(data + i, n_elems - i);
+        if(tail_min < min) min = tail_min;
+    }
+
+    return min;
+}
+
+__attribute__((target("avx2")))
+static elem_t max_avx2(const elem_t *data, const size_t n_elems)
+{
+    if(n_elems < Avx2_width) return max_scalar(data, n_elems);
+
+    __m256i maxs = LOAD_AVX2(data);
+
+    size_t i = Avx2_width;
+    for(; i + Avx2_width <= n_elems; i += Avx2_width)
+    {
+        __m256i vals = LOAD_AVX2(data + i);
+        maxs = _mm256_blendv_epi8(maxs, vals, _mm256_cmpgt_epi64(vals, maxs));
+    }
+
+    elem_t lanes[Avx2_width] = {};
+    _mm256_storeu_si256((__m256i *)lanes, maxs);
+
+    elem_t max = max_scalar(lanes, Avx2_width);
+    if(i < n_elems)
+    {
+        elem_t tail_max = max_scalar(data + i, n_elems - i);
+        if(tail_max > max) max = tail_max;
+    }
+
+    return max;
+}
+
+#undef LOAD_AVX2
+
+#endif
+
+/**
+ * @brief Chooses kernels for the running CPU.
+ */
+static Kernels select_kernels(void)
+{
+#ifdef KERNELS_X86
+
+    __builtin_cpu_init();
+
+    if(__builtin_cpu_supports("avx2"))
+    {
+        return {find_avx2, count_avx2, sum_avx2, min_avx2, max_avx2};
+    }
+
+#endif
+
+    return {find_scalar, count_scalar, sum_scalar, min_scalar, max_scalar};
+}
+
+/**
+ * @brief Kernels chosen at the first call.
+ */
+static const Kernels &kernels(void)
+{
+    static const Kernels Selected = select_kernels();
+
+    return Selected;
+}
+
+size_t kernel_find(const elem_t *data, const size_t n_elems, const elem_t val)
+{
+    assert(data || n_elems == 0);
+
+    return kernels().find(data, n_elems, val);
+}
+
+size_t kernel_count(const elem_t *data, const size_t n_elems, const elem_t val)
+{
+    assert(data || n_elems == 0);
+
+    return kernels().count(data, n_elems, val);
+}
+
+elem_t kernel_sum(const elem_t *data, const size_t n_elems)
+{
+    assert(data || n_elems == 0);
+
+    return kernels().sum(data, n_elems);
+}
+
+elem_t kernel_min(const elem_t *data, const size_t n_elems)
+{
+    assert(data);
+    assert(n_elems > 0);
+
+    return kernels().min(data, n_elems);
+}
+
+elem_t kernel_max(const elem_t *data, const size_t n_elems)
+{
+    assert(data);
+    assert(n_elems > 0);
+
+    return kernels().max(data, n_elems);
+}
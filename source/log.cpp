@@ -1,15 +1,11 @@
-#define LOG_CPP
-
 #include <stdio.h>
 #include <stdlib.h>
 
 #include "../include/log.h"
 
-FILE *LOG_FILE = open_log();
-
-FILE *open_log(void)
+FILE *open_log(const char *path)
 {
-    FILE *file = fopen("log.log", "wb");
+    FILE *file = fopen(path, "wb");
     if(file == NULL)
     {
         fprintf(stderr, "Can`t open log-file.\n"
@@ -18,18 +14,23 @@ FILE *open_log(void)
         return stderr;
     }
 
-    atexit(close_log);
-
     setbuf(file, NULL);
 
     return file;
 }
 
-void close_log(void)
+void close_log(FILE *file)
 {
-    fflush(LOG_FILE);
+    if(file == NULL || file == stderr || file == stdout) return;
+
+    fflush(file);
 
-    fclose(LOG_FILE);
+    fclose(file);
 }
 
-#undef LOG_CPP
\ No newline at end of file
+FILE *log_file(void)
+{
+    static FILE *Log_file = open_log(Default_log_path);
+
+    return Log_file;
+}
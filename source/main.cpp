@@ -1,8 +1,6 @@
 #include "../include/stack.h"
 #include <stdio.h>
 
-extern struct Stack Stacks[];
-
 int main(void)
 {
     stk_d stack1 = 0;
@@ -0,0 +1,425 @@
+/**
+ * @file shm_stack.cpp
+ * @author GraY
+ * @brief Shared stack definitions.
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "../include/log.h"
+#include "../include/shm_stack.h"
+
+static const unsigned long long Shm_magic = 0x31534B4341545348; ///< "HSTACKS1", written last when segment is ready.
+static const size_t             Shm_align = 64;
+static const size_t             P         = 257;
+
+/**
+ * @brief Header of the shared segment. Every field is position-independent.
+ */
+struct Shm_header
+{
+    canary_t           canary_left;  ///< Left @b Canary.
+    unsigned long long magic;        ///< @b Shm_magic if segment is initialized.
+
+    size_t             capacity;     ///< Max number of elements.
+    size_t             data_offset;  ///< Offset of @b data from the start of the segment.
+    size_t             size;         ///< Number of elements.
+
+    size_t             data_hash;    ///< Hash of elements [0, size), updated by parts on every push and pop.
+    size_t             stack_hash;   ///< Hash of the fields above.
+
+    pid_t              writer_pid;   ///< Last process which changed the stack.
+    pthread_mutex_t    mutex;        ///< Robust process-shared mutex.
+
+    canary_t           canary_right; ///< Right @b Canary.
+};
+
+#define SHM_DATA(header)       ((elem_t       *)((char       *)(header) + (header)->data_offset))
+#define SHM_CONST_DATA(header) ((const elem_t *)((const char *)(header) + (header)->data_offset))
+
+static size_t data_offset(void)
+{
+    return (sizeof(Shm_header) + sizeof(canary_t) + Shm_align - 1) & ~(Shm_align - 1);
+}
+
+static size_t segment_size(const size_t capacity)
+{
+    return data_offset() + capacity * sizeof(elem_t) + sizeof(canary_t);
+}
+
+/**
+ * @brief Polynomial hash of element @b val lying at @b index, so that hash of [0, size) is a sum over elements.
+ */
+static size_t elem_hash(const elem_t val, const size_t index)
+{
+    size_t powered_P = 1;
+    size_t base      = P;
+
+    for(size_t exp = index * sizeof(elem_t); exp; exp >>= 1)
+    {
+        if(exp & 1) powered_P *= base;
+        base *= base;
+    }
+
+    size_t hash = 0;
+
+    for(size_t i = 0; i < sizeof(elem_t); i++)
+    {
+        hash      += (size_t)((const char *)&val)[i] * powered_P;
+        powered_P *= P;
+    }
+
+    return hash;
+}
+
+static size_t header_hash(const Shm_header *header)
+{
+    return header->capacity * P * P * P + header->data_offset * P * P + header->size * P + header->data_hash;
+}
+
+/**
+ * @brief Cheap check done on every operation: canaries, segment size and header hash.
+ * Data canaries are read only after header is known to match the mapping of @b map_size bytes.
+ */
+static bool header_valid(const Shm_header *header, const size_t map_size)
+{
+    if(header->canary_left != Canary_val || header->canary_right != Canary_val ||
+       header->data_offset != data_offset() || header->capacity > map_size / sizeof(elem_t) ||
+       segment_size(header->capacity) != map_size || header->size > header->capacity ||
+       header->stack_hash  != header_hash(header))
+    {
+        return false;
+    }
+
+    const elem_t *data = SHM_CONST_DATA(header);
+
+    return ((const canary_t *)data)[-1] == Canary_val && *(const canary_t *)(data + header->capacity) == Canary_val;
+}
+
+/**
+ * @brief Full check: header and hash of all elements.
+ */
+static bool stack_valid(const Shm_header *header, const size_t map_size)
+{
+    if(!header_valid(header, map_size)) return false;
+
+    const elem_t *data = SHM_CONST_DATA(header);
+
+    size_t hash = 0;
+    for(size_t i = 0; i < header->size; i++) hash += elem_hash(data[i], i);
+
+    return hash == header->data_hash;
+}
+
+/**
+ * @brief Locks shared stack. Takes the stack over if previous owner died and left it consistent.
+ */
+static int shm_lock(const Shm_stack *stack)
+{
+    Shm_header *header = stack->header;
+
+    int err_code = pthread_mutex_lock(&header->mutex);
+
+    if(err_code == EOWNERDEAD)
+    {
+        LOG("%s: In %s: warning: Process %d died holding shared stack.\n", __FILE__, __PRETTY_FUNCTION__, header->writer_pid);
+
+        if(!stack_valid(header, stack->map_size))
+        {
+            LOG("%s: In %s: error: Shared stack was left corrupted.\n", __FILE__, __PRETTY_FUNCTION__);
+
+            pthread_mutex_unlock(&header->mutex);
+
+            return ENOTRECOVERABLE;
+        }
+
+        pthread_mutex_consistent(&header->mutex);
+
+        return EXIT_SUCCESS;
+    }
+
+    if(err_code)
+    {
+        LOG("%s: In %s: error: Unable to lock shared stack (%d).\n", __FILE__, __PRETTY_FUNCTION__, err_code);
+    }
+
+    return err_code;
+}
+
+/**
+ * @brief Locks shared stack and verifies it`s header. Returns error code from the calling function on failure.
+ */
+#define SHM_LOCK_VERIFICATION(stack)    { \
+                                            int lock_err = shm_lock(stack); \
+                                            if(lock_err) return lock_err; \
+                                            \
+                                            if(!header_valid((stack)->header, (stack)->map_size)) \
+                                            { \
+                                                LOG("%s: In %s: error: Corrupted shared stack.\n", __FILE__, __PRETTY_FUNCTION__); \
+                                                \
+                                                pthread_mutex_unlock(&(stack)->header->mutex); \
+                                                \
+                                                return EINVAL; \
+                                            } \
+                                        }
+
+static void init_shared_mutex(pthread_mutex_t *mutex)
+{
+    static thread_local pthread_mutexattr_t attr = {}; // Not on the stack: -Wstack-protector complains about it.
+
+    pthread_mutexattr_init      (&attr);
+    pthread_mutexattr_setpshared(&attr, PTHREAD_PROCESS_SHARED);
+    pthread_mutexattr_setrobust (&attr, PTHREAD_MUTEX_ROBUST);
+    pthread_mutex_init(mutex, &attr);
+    pthread_mutexattr_destroy(&attr);
+}
+
+static int map_segment(Shm_stack *stack, const int fd, const size_t map_size)
+{
+    void *map = mmap(NULL, map_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+    close(fd);
+
+    if(map == MAP_FAILED)
+    {
+        LOG("%s: In %s: error: Unable to map shared stack.\n", __FILE__, __PRETTY_FUNCTION__);
+
+        return errno;
+    }
+
+    stack->header   = (Shm_header *)map;
+    stack->map_size = map_size;
+
+    return EXIT_SUCCESS;
+}
+
+int shm_stack_create(Shm_stack *stack, const char *name, const size_t capacity)
+{
+    assert(stack);
+    assert(name);
+
+    *stack = {};
+
+    if(capacity == 0)
+    {
+        LOG("%s: In %s: error: Capasity should be greater than zero.\n", __FILE__, __PRETTY_FUNCTION__);
+
+        return EINVAL;
+    }
+
+    int fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR);
+    if(fd < 0)
+    {
+        LOG("%s: In %s: error: Unable to create shared stack %s.\n", __FILE__, __PRETTY_FUNCTION__, name);
+
+        return errno;
+    }
+
+    if(ftruncate(fd, (off_t)segment_size(capacity)))
+    {
+        int err_code = errno;
+
+        LOG("%s: In %s: error: Unable to allocate shared stack %s.\n", __FILE__, __PRETTY_FUNCTION__, name);
+
+        close(fd);
+        shm_unlink(name);
+
+        return err_code;
+    }
+
+    int err_code = map_segment(stack, fd, segment_size(capacity));
+    if(err_code)
+    {
+        shm_unlink(name);
+
+        return err_code;
+    }
+
+    Shm_header *header = stack->header;
+
+    header->canary_left  = Canary_val;
+    header->canary_right = Canary_val;
+    header->capacity     = capacity;
+    header->data_offset  = data_offset();
+    header->writer_pid   = getpid();
+
+    ((canary_t *)SHM_DATA(header))[-1]         = Canary_val;
+    *(canary_t *)(SHM_DATA(header) + capacity) = Canary_val;
+
+    header->stack_hash = header_hash(header);
+
+    init_shared_mutex(&header->mutex);
+
+    __atomic_store_n(&header->magic, Shm_magic, __ATOMIC_RELEASE);
+
+    return EXIT_SUCCESS;
+}
+
+int shm_stack_open(Shm_stack *stack, const char *name)
+{
+    assert(stack);
+    assert(name);
+
+    *stack = {};
+
+    int fd = shm_open(name, O_RDWR, 0);
+    if(fd < 0)
+    {
+        LOG("%s: In %s: error: Unable to open shared stack %s.\n", __FILE__, __PRETTY_FUNCTION__, name);
+
+        return errno;
+    }
+
+    struct stat segment_stat = {};
+    if(fstat(fd, &segment_stat) || (size_t)segment_stat.st_size < segment_size(1))
+    {
+        close(fd);
+
+        return EAGAIN;
+    }
+
+    int err_code = map_segment(stack, fd, (size_t)segment_stat.st_size);
+    if(err_code) return err_code;
+
+    if(__atomic_load_n(&stack->header->magic, __ATOMIC_ACQUIRE) != Shm_magic)
+    {
+        shm_stack_close(stack);
+
+        return EAGAIN;
+    }
+
+    if(segment_size(stack->header->capacity) != stack->map_size)
+    {
+        LOG("%s: In %s: error: Shared stack %s has wrong size.\n", __FILE__, __PRETTY_FUNCTION__, name);
+
+        shm_stack_close(stack);
+
+        return EINVAL;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+int shm_stack_close(Shm_stack *stack)
+{
+    assert(stack);
+
+    if(stack->header && munmap(stack->header, stack->map_size))
+    {
+        return errno;
+    }
+
+    *stack = {};
+
+    return EXIT_SUCCESS;
+}
+
+int shm_stack_unlink(const char *name)
+{
+    assert(name);
+
+    return shm_unlink(name) ? errno : EXIT_SUCCESS;
+}
+
+int shm_stack_push(Shm_stack *stack, const elem_t val)
+{
+    assert(stack && stack->header);
+
+    Shm_header *header = stack->header;
+
+    SHM_LOCK_VERIFICATION(stack);
+
+    if(header->size == header->capacity)
+    {
+        pthread_mutex_unlock(&header->mutex);
+
+        return ENOBUFS;
+    }
+
+    header->writer_pid = getpid();
+
+    SHM_DATA(header)[header->size] = val;
+    header->data_hash += elem_hash(val, header->size);
+    header->size++;
+    header->stack_hash = header_hash(header);
+
+    pthread_mutex_unlock(&header->mutex);
+
+    return EXIT_SUCCESS;
+}
+
+int shm_stack_pop(Shm_stack *stack, elem_t *ret_val)
+{
+    assert(stack && stack->header);
+
+    Shm_header *header = stack->header;
+
+    SHM_LOCK_VERIFICATION(stack);
+
+    if(header->size == 0)
+    {
+        pthread_mutex_unlock(&header->mutex);
+
+        return EAGAIN;
+    }
+
+    header->writer_pid = getpid();
+
+    elem_t value = SHM_DATA(header)[header->size - 1];
+
+    header->size--;
+    header->data_hash -= elem_hash(value, header->size);
+    header->stack_hash = header_hash(header);
+
+    SHM_DATA(header)[header->size] = 0;
+
+    pthread_mutex_unlock(&header->mutex);
+
+    if(ret_val) *ret_val = value;
+
+    return EXIT_SUCCESS;
+}
+
+int shm_stack_size(Shm_stack *stack, size_t *size)
+{
+    assert(stack && stack->header);
+    assert(size);
+
+    Shm_header *header = stack->header;
+
+    SHM_LOCK_VERIFICATION(stack);
+
+    *size = header->size;
+
+    pthread_mutex_unlock(&header->mutex);
+
+    return EXIT_SUCCESS;
+}
+
+int shm_stack_validation(Shm_stack *stack)
+{
+    assert(stack && stack->header);
+
+    Shm_header *header = stack->header;
+
+    int err_code = shm_lock(stack);
+    if(err_code) return err_code;
+
+    bool valid = stack_valid(header, stack->map_size);
+
+    pthread_mutex_unlock(&header->mutex);
+
+    return valid ? EXIT_SUCCESS : EINVAL;
+}
+
+#undef SHM_DATA
+#undef SHM_CONST_DATA
+#undef SHM_LOCK_VERIFICATION
@@ -8,121 +8,316 @@
 #include <errno.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
+#include <new>
+
+#include "../include/kernels.h"
 #include "../include/stack.h"
+#include "../include/stack_audit.h"
+#include "../include/stack_context.h"
+
+#if STACK_THREAD_SAFE
+#define REGISTRY_LOCK() std::lock_guard<std::mutex> registry_guard(context->registry_lock)
+#else
+#define REGISTRY_LOCK()
+#endif
+
+inline namespace STACK_ABI_NS
+{
+
+/**
+ * @brief Default allocator of @b data: aligned_alloc() if @b alignment is given, malloc() otherwise.
+ */
+static void *default_alloc(const size_t alignment, const size_t n_bytes)
+{
+    return alignment ? aligned_alloc(alignment, n_bytes) : malloc(n_bytes);
+}
+
+/**
+ * @brief Allocates zeroed @b data allocation of @b n_bytes bytes, aligned to @b STACK_ALIGN.
+ */
+static void *data_calloc(Stack_context *context, const size_t n_bytes)
+{
+    void *alloc = context->allocator.alloc(STACK_ALIGN, n_bytes);
+    if(alloc) memset(alloc, 0, n_bytes);
+
+    return alloc;
+}
+
+/**
+ * @brief Reallocates @b data allocation keeping it aligned to @b STACK_ALIGN.
+ * There is no aligned realloc() and no realloc() in user allocators, so allocation is moved by hand.
+ * @return void* New allocation or @b NULL, old one is left untouched then.
+ */
+static void *data_realloc(Stack_context *context, void *alloc, const size_t old_n_bytes, const size_t new_n_bytes)
+{
+    if(!STACK_ALIGN && context->allocator.alloc == default_alloc)
+    {
+        return realloc(alloc, new_n_bytes);
+    }
+
+    void *new_alloc = context->allocator.alloc(STACK_ALIGN, new_n_bytes);
+    if(!new_alloc) return NULL;
+
+    memcpy(new_alloc, alloc, (old_n_bytes < new_n_bytes) ? old_n_bytes : new_n_bytes);
+    context->allocator.dealloc(alloc);
+
+    return new_alloc;
+}
+
+int stack_library_init(Stack_context **context_ptr, const Stack_library_config *config)
+{
+    static const Stack_library_config Default_config = {};
+
+    assert(context_ptr);
+
+    *context_ptr = NULL;
+
+    if(config == NULL) config = &Default_config;
+
+    Stack_context *context = new (std::nothrow) Stack_context();
+    if(!context) return ENOMEM;
+
+    context->log_path = config->log_path ? config->log_path : Default_log_path;
+    context->log      = config->log_file;
+
+    if((config->allocator.alloc == NULL) != (config->allocator.dealloc == NULL))
+    {
+        LOG("%s: In %s: error: Allocator should have both alloc and dealloc.\n", __FILE__, __PRETTY_FUNCTION__);
+
+        if(context->own_log) close_log(context->log);
+        delete context;
+
+        return EINVAL;
+    }
+
+    context->allocator  = config->allocator.alloc ? config->allocator : Stack_allocator{default_alloc, free};
+    context->max_stacks = config->max_stacks ? config->max_stacks : Default_max_stacks;
+
+    context->stacks = new (std::nothrow) Stack[context->max_stacks]{};
+    if(!context->stacks)
+    {
+        LOG("%s: In %s: error: Unable to allocate descriptor table.\n", __FILE__, __PRETTY_FUNCTION__);
+
+        if(context->own_log) close_log(context->log);
+        delete context;
+
+        return ENOMEM;
+    }
+
+    context->n_buffered_stacks = 1;
+
+    *context_ptr = context;
+
+    return EXIT_SUCCESS;
+}
 
-static size_t N_buffered_stacks = 1;
-static const int Max_stacks     = 100;
-static struct Stack Stacks[Max_stacks] = {};
+/**
+ * @brief Writes summary of errors dropped by the rate limit. Records are dropped only after some are written,
+ * so log-file is not opened just for the summary.
+ */
+static void flush_errors(Stack_context *context)
+{
+    if(context->log) report_stack_error_flush(&context->reporter, context->log);
+}
 
-int stack_ctor(stk_d *stack_descriptor, const size_t capacity)
+int stack_library_destroy(Stack_context *context)
 {
-    static stk_d Stack_D = 1;
+    assert(context);
+
+    stack_audit_stop(context);
 
-    assert(Stacks);
+    for(stk_d stack_descriptor = 1; stack_descriptor < context->n_buffered_stacks; stack_descriptor++)
+    {
+        if(context->stacks[stack_descriptor].data) stack_dtor(context, stack_descriptor);
+    }
+
+    flush_errors(context);
+
+    if(context->own_log) close_log(context->log);
+
+    delete[] context->stacks;
+    delete   context;
+
+    return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Stops auditor of the default context before static objects are destroyed and reports dropped errors.
+ */
+static void default_context_at_exit(void)
+{
+    stack_audit_stop(stack_default_context());
+
+    flush_errors(stack_default_context());
+}
+
+Stack_context *stack_default_context(void)
+{
+    static Stack_context *Default_context = []
+    {
+        Stack_context *context = NULL;
+        stack_library_init(&context);
+
+        atexit(default_context_at_exit);
+
+        return context;
+    }();
+
+    assert(Default_context);
+
+    return Default_context;
+}
+
+FILE *stack_log_file(Stack_context *context)
+{
+    assert(context);
+
+    std::call_once(context->log_once, [context]
+    {
+        if(context->log == NULL)
+        {
+            context->log     = open_log(context->log_path);
+            context->own_log = true;
+        }
+    });
+
+    return context->log;
+}
+
+int stack_ctor(Stack_context *context, stk_d *stack_descriptor, const size_t capacity)
+{
+    assert(context);
     assert(stack_descriptor);
 
     *stack_descriptor = 0;
 
     if(capacity == 0)
     {
-        fprintf(LOG_FILE, "%s: In %s: error: Capasity should be greater than zero.\n", __FILE__, __PRETTY_FUNCTION__);
+        LOG("%s: In %s: error: Capasity should be greater than zero.\n", __FILE__, __PRETTY_FUNCTION__);
 
         return EINVAL;
     }
 
-    if(Stack_D >= Max_stacks)
+    if(capacity > MAX_CAPACITY)
+    {
+        LOG("%s: In %s: error: Capasity is too big.\n", __FILE__, __PRETTY_FUNCTION__);
+
+        return ENOMEM;
+    }
+
+    REGISTRY_LOCK();
+
+    stk_d new_stack_d = context->n_buffered_stacks;
+
+    if(new_stack_d >= context->max_stacks)
     {
-        fprintf(LOG_FILE, "%s: In %s: error: Max stacks limit reached.\n", __FILE__, __PRETTY_FUNCTION__);
+        LOG("%s: In %s: error: Max stacks limit reached.\n", __FILE__, __PRETTY_FUNCTION__);
 
         return EACCES;
     }
 
-    N_buffered_stacks++;
-    struct Stack *stack = Stacks + Stack_D;
+    struct Stack *stack = context->stacks + new_stack_d;
 
+    *stack = {};
     stack->capacity = capacity;
 
-#ifdef PROTECT
+    void *data_alloc = data_calloc(context, DATA_ALLOC_SIZE(capacity));
+    if(!data_alloc)
+    {
+        LOG("%s: In %s:%d: error: Unable to allocate memory.\n", __FILE__, __PRETTY_FUNCTION__, __LINE__ - 3);
 
-    stack->canary_left  = Canary_val;
-    stack->canary_right = Canary_val;
+        return ENOMEM;
+    }
 
-    stack->data = (elem_t *)((canary_t *)calloc(capacity * sizeof(elem_t) + 2 * sizeof(canary_t), sizeof(char)) + 1);
+    stack->data = ALLOC_TO_DATA(data_alloc);
 
-    HASH_STACK(stack);
+#if STACK_CANARY
 
-    STACK_VERIFICATION(Stack_D, ENOMEM, "%s: In %s:%d: error: Unable to allocate memory.\n", __FILE__, __PRETTY_FUNCTION__, __LINE__ - 2);
+    stack->canary_left  = Canary_val;
+    stack->canary_right = Canary_val;
 
     ((canary_t *)stack->data)[-1]                = Canary_val;
     *(canary_t *)(stack->data + stack->capacity) = Canary_val;
 
-    STACK_DATA_VERIFICATION(Stack_D);
+#endif
 
-#else
+    HASH_STACK(stack);
 
-    stack->data = (elem_t *)calloc(capacity * sizeof(elem_t), sizeof(char));
-    if(!stack->data)
-    {
-        fprintf(LOG_FILE, "%s: In %s:%d: error: Unable to allocate memory.\n", __FILE__, __PRETTY_FUNCTION__, __LINE__ - 3);
+    STACK_VERIFICATION(context, new_stack_d, EINVAL);
 
-        return ENOMEM;
-    }
+    STACK_DATA_VERIFICATION(context, new_stack_d);
 
-#endif
+    *stack_descriptor = new_stack_d;
 
-    *stack_descriptor = Stack_D;
-    Stack_D++;
+    context->n_buffered_stacks++;
 
     return EXIT_SUCCESS;
 }
 
-int stack_dtor(const stk_d stack_descriptor)
+int stack_dtor(Stack_context *context, const stk_d stack_descriptor)
 {
-    STACK_DESCRIPTOR_VERIFICATION(stack_descriptor);
+    STACK_DESCRIPTOR_VERIFICATION(context, stack_descriptor);
 
-    struct Stack *stack = Stacks + stack_descriptor;
+    struct Stack *stack = context->stacks + stack_descriptor;
 
     assert(stack);
 
+    REGISTRY_LOCK();
+    STACK_LOCK(stack);
+
+    if(stack->data == NULL)
+    {
+        return stack_error(context, stack_descriptor, EINVAL, __FILE__, __PRETTY_FUNCTION__, __LINE__);
+    }
+
+    context->allocator.dealloc(DATA_TO_ALLOC(stack->data));
+
+    stack->data     = NULL;
     stack->size     = 0;
     stack->capacity = 0;
 
-#ifdef PROTECT
+#if STACK_CANARY
 
     stack->canary_left  = 0;
     stack->canary_right = 0;
 
+#endif
+
+#if STACK_HASH
+
     stack->data_hash  = 0;
     stack->stack_hash = 0;
 
+#endif
+
+#if STACK_PROTECT
+
     stack->err          = {};
     stack->err.invalid  = true;
     stack->err.sizeless = true;
     stack->err.no_data  = true;
 
-    free((canary_t *)stack->data - 1);
-
-#else
-
-    free(stack->data);
-
 #endif
 
     return EXIT_SUCCESS;
 }
 
-int push_stack(const stk_d stack_descriptor, const elem_t val)
+int push_stack(Stack_context *context, const stk_d stack_descriptor, const elem_t val)
 {
-    struct Stack *stack = Stacks + stack_descriptor;
+    STACK_DESCRIPTOR_VERIFICATION(context, stack_descriptor);
+
+    struct Stack *stack = context->stacks + stack_descriptor;
 
-    VERIFICATION(stack_descriptor, EINVAL, "Error: invalid stack.\n"
-                                                   "%s: In function %s:%d\n", __FILE__, __PRETTY_FUNCTION__, __LINE__ - 1);
+    STACK_LOCK(stack);
+
+    VERIFICATION(context, stack_descriptor, EINVAL);
 
     int err_code = 0;
-    if((err_code = optimal_expansion(stack_descriptor)))
+    if((err_code = optimal_expansion(context, stack_descriptor)))
     {
-        fprintf(LOG_FILE, "%s: In function %s:%d\n", __FILE__, __PRETTY_FUNCTION__, __LINE__ - 2);
+        LOG("%s: In function %s:%d\n", __FILE__, __PRETTY_FUNCTION__, __LINE__ - 2);
 
         return err_code;
     }
@@ -131,34 +326,38 @@ int push_stack(const stk_d stack_descriptor, const elem_t val)
 
     HASH_STACK(stack);
 
-    VERIFICATION(stack_descriptor, EINVAL, "Error: invalid stack.\n"
-                                                   "%s: In function %s:%d\n", __FILE__, __PRETTY_FUNCTION__, __LINE__ - 1);
+    VERIFICATION(context, stack_descriptor, EINVAL);
 
     return EXIT_SUCCESS;
 }
 
-int pop_stack(const stk_d stack_descriptor, elem_t *ret_val)
+int pop_stack(Stack_context *context, const stk_d stack_descriptor, elem_t *ret_val)
 {
-    struct Stack *stack = Stacks + stack_descriptor;
+    STACK_DESCRIPTOR_VERIFICATION(context, stack_descriptor);
+
+    struct Stack *stack = context->stacks + stack_descriptor;
+
+    STACK_LOCK(stack);
 
-    VERIFICATION(stack_descriptor, EINVAL, "Error: invalid stack.\n"
-                                                   "%s: In function %s:%d\n", __FILE__, __PRETTY_FUNCTION__, __LINE__ - 1);
+    VERIFICATION(context, stack_descriptor, EINVAL);
 
     if(stack->size == 0)
     {
-        fprintf(LOG_FILE, "Error: stack underflow.\n"
-                          "%s: In function %s\n", __FILE__, __PRETTY_FUNCTION__);
-
-#ifdef PROTECT
+#if STACK_PROTECT
 
         stack->err.invalid   = true;
         stack->err.underflow = true;
 
-#endif
+        return stack_error(context, stack_descriptor, EINVAL, __FILE__, __PRETTY_FUNCTION__, __LINE__);
 
-        HASH_STACK(stack);
+#else
+
+        LOG("Error: stack underflow.\n"
+            "%s: In function %s\n", __FILE__, __PRETTY_FUNCTION__);
 
         return EINVAL;
+
+#endif
     }
 
     elem_t value = stack->data[--stack->size];
@@ -169,46 +368,57 @@ int pop_stack(const stk_d stack_descriptor, elem_t *ret_val)
     if(ret_val) *ret_val = value;
 
     int err_code = 0;
-    if((err_code = optimal_shrink(stack_descriptor)))
+    if((err_code = optimal_shrink(context, stack_descriptor)))
     {
-        fprintf(LOG_FILE, "%s: In function %s:%d\n", __FILE__, __PRETTY_FUNCTION__, __LINE__ - 2);
+        LOG("%s: In function %s:%d\n", __FILE__, __PRETTY_FUNCTION__, __LINE__ - 2);
 
         return err_code;
     }
 
-    VERIFICATION(stack_descriptor, EINVAL, "Error: invalid stack.\n"
-                                                   "%s: In function %s:%d\n", __FILE__, __PRETTY_FUNCTION__, __LINE__ - 1);
+    VERIFICATION(context, stack_descriptor, EINVAL);
 
     return EXIT_SUCCESS;
 }
 
-int optimal_expansion(const stk_d stack_descriptor)
+int optimal_expansion(Stack_context *context, const stk_d stack_descriptor)
 {
-    struct Stack *stack = Stacks + stack_descriptor;
+    STACK_DESCRIPTOR_VERIFICATION(context, stack_descriptor);
+
+    struct Stack *stack = context->stacks + stack_descriptor;
 
-    VERIFICATION(stack_descriptor, EINVAL, "Error: invalid stack.\n"
-                                                   "%s: In function %s:%d\n", __FILE__, __PRETTY_FUNCTION__, __LINE__ - 1);
+    STACK_LOCK(stack);
+
+    VERIFICATION(context, stack_descriptor, EINVAL);
 
     if(stack->size == stack->capacity)
     {
-        elem_t *temp_ptr = REALLOC_DATA_UP(stack, 2);
+        if(stack->capacity > MAX_CAPACITY / Config.growth)
+        {
+            LOG("Error: stack capacity limit reached.\n"
+                "%s: In function %s\n", __FILE__, __PRETTY_FUNCTION__);
+
+            return ENOMEM;
+        }
+
+        void *temp_ptr = REALLOC_DATA_UP(context, stack, Config.growth);
 
         if(!temp_ptr)
         {
-            fprintf(LOG_FILE, "Error: unable to reallocate memory.\n"
-                              "%s: In function %s:%d\n", __FILE__, __PRETTY_FUNCTION__, __LINE__ - 10);
+            LOG("Error: unable to reallocate memory.\n"
+                "%s: In function %s:%d\n", __FILE__, __PRETTY_FUNCTION__, __LINE__ - 4);
 
             return ENOMEM;
         }
 
-        stack->data = temp_ptr;
+        stack->data      = ALLOC_TO_DATA(temp_ptr);
+        stack->capacity *= Config.growth;
 
         for(size_t i = stack->size; i < stack->capacity; i++)
         {
             stack->data[i] = 0;
         }
 
-#ifdef PROTECT
+#if STACK_CANARY
 
         *(canary_t *)(stack->data + stack->capacity) = Canary_val;
 
@@ -217,34 +427,37 @@ int optimal_expansion(const stk_d stack_descriptor)
         HASH_STACK(stack);
     }
 
-    VERIFICATION(stack_descriptor, EINVAL, "Error: invalid stack.\n"
-                                                   "%s: In function %s:%d\n", __FILE__, __PRETTY_FUNCTION__, __LINE__ - 1);
+    VERIFICATION(context, stack_descriptor, EINVAL);
 
     return EXIT_SUCCESS;
 }
 
-int optimal_shrink(const stk_d stack_descriptor)
+int optimal_shrink(Stack_context *context, const stk_d stack_descriptor)
 {
-    struct Stack *stack = Stacks + stack_descriptor;
+    STACK_DESCRIPTOR_VERIFICATION(context, stack_descriptor);
 
-    VERIFICATION(stack_descriptor, EINVAL, "Error: invalid stack.\n"
-                                                   "%s: In function %s:%d\n", __FILE__, __PRETTY_FUNCTION__, __LINE__ - 1);
+    struct Stack *stack = context->stacks + stack_descriptor;
 
-    if(stack->size * 4 == stack->capacity)
+    STACK_LOCK(stack);
+
+    VERIFICATION(context, stack_descriptor, EINVAL);
+
+    if(stack->size * Config.growth * Config.growth == stack->capacity)
     {
-        elem_t *temp_ptr = REALLOC_DATA_DOWN(stack, 2);
+        void *temp_ptr = REALLOC_DATA_DOWN(context, stack, Config.growth);
 
         if(!temp_ptr)
         {
-            fprintf(LOG_FILE, "Error: unable to reallocate memory.\n"
-                              "%s: In function %s:%d\n", __FILE__, __PRETTY_FUNCTION__, __LINE__ - 10);
+            LOG("Error: unable to reallocate memory.\n"
+                "%s: In function %s:%d\n", __FILE__, __PRETTY_FUNCTION__, __LINE__ - 4);
 
             return ENOMEM;
         }
 
-        stack->data = temp_ptr;
+        stack->data      = ALLOC_TO_DATA(temp_ptr);
+        stack->capacity /= Config.growth;
 
-#ifdef PROTECT
+#if STACK_CANARY
 
         *(canary_t *)(stack->data + stack->capacity) = Canary_val;
 
@@ -253,130 +466,427 @@ int optimal_shrink(const stk_d stack_descriptor)
         HASH_STACK(stack);
     }
 
-    VERIFICATION(stack_descriptor, EINVAL, "Error: invalid stack.\n"
-                                                   "%s: In function %s:%d\n", __FILE__, __PRETTY_FUNCTION__, __LINE__ - 1);
+    VERIFICATION(context, stack_descriptor, EINVAL);
 
     return EXIT_SUCCESS;
 }
 
-int clear_stack(const stk_d stack_descriptor)
+int stack_reserve(Stack_context *context, const stk_d stack_descriptor, const size_t n_elems)
 {
-    struct Stack *stack = Stacks + stack_descriptor;
+    STACK_DESCRIPTOR_VERIFICATION(context, stack_descriptor);
+
+    struct Stack *stack = context->stacks + stack_descriptor;
+
+    STACK_LOCK(stack);
+
+    VERIFICATION(context, stack_descriptor, EINVAL);
+
+    if(stack->capacity - stack->size < n_elems)
+    {
+        if(n_elems > MAX_CAPACITY - stack->size)
+        {
+            LOG("Error: unable to reserve %zu elements, stack capacity limit reached.\n"
+                "%s: In function %s\n", n_elems, __FILE__, __PRETTY_FUNCTION__);
+
+            return ENOMEM;
+        }
+
+        size_t new_capacity = stack->capacity;
+        while(new_capacity - stack->size < n_elems)
+        {
+            new_capacity = (new_capacity > MAX_CAPACITY / Config.growth) ? stack->size + n_elems : new_capacity * Config.growth;
+        }
 
-    VERIFICATION(stack_descriptor, EINVAL, "Error: invalid stack.\n"
-                                                   "%s: In function %s:%d\n", __FILE__, __PRETTY_FUNCTION__, __LINE__ - 1);
+        void *temp_ptr = data_realloc(context, DATA_TO_ALLOC(stack->data), DATA_ALLOC_SIZE(stack->capacity), DATA_ALLOC_SIZE(new_capacity));
+
+        if(!temp_ptr)
+        {
+            LOG("Error: unable to reallocate memory.\n"
+                "%s: In function %s:%d\n", __FILE__, __PRETTY_FUNCTION__, __LINE__ - 4);
+
+            return ENOMEM;
+        }
+
+        stack->data = ALLOC_TO_DATA(temp_ptr);
+
+        for(size_t i = stack->capacity; i < new_capacity; i++)
+        {
+            stack->data[i] = 0;
+        }
+
+        stack->capacity = new_capacity;
+
+#if STACK_CANARY
+
+        *(canary_t *)(stack->data + stack->capacity) = Canary_val;
+
+#endif
+
+        HASH_STACK(stack);
+    }
+
+    VERIFICATION(context, stack_descriptor, EINVAL);
+
+    return EXIT_SUCCESS;
+}
+
+int clear_stack(Stack_context *context, const stk_d stack_descriptor)
+{
+    STACK_DESCRIPTOR_VERIFICATION(context, stack_descriptor);
+
+    struct Stack *stack = context->stacks + stack_descriptor;
+
+    STACK_LOCK(stack);
+
+    VERIFICATION(context, stack_descriptor, EINVAL);
 
     while(stack->size != 0) stack->data[--stack->size] = 0;
 
     HASH_STACK(stack);
 
     int err_code = 0;
-    if((err_code = optimal_shrink(stack_descriptor)))
+    if((err_code = optimal_shrink(context, stack_descriptor)))
     {
-        fprintf(LOG_FILE, "%s: In function %s:%d\n", __FILE__, __PRETTY_FUNCTION__, __LINE__ - 2);
+        LOG("%s: In function %s:%d\n", __FILE__, __PRETTY_FUNCTION__, __LINE__ - 2);
 
         return err_code;
     }
 
-    VERIFICATION(stack_descriptor, EINVAL, "Error: invalid stack.\n"
-                                           "%s: In function %s:%d\n", __FILE__, __PRETTY_FUNCTION__, __LINE__ - 1);
+    VERIFICATION(context, stack_descriptor, EINVAL);
 
     return EXIT_SUCCESS;
 }
 
-int stack_dump(const stk_d stack_descriptor, const char *Stack_Name, const char *file_name, const char * func_declaration, const int line)
+int stack_dump(Stack_context *context, const stk_d stack_descriptor, [[maybe_unused]] const char *Stack_Name, [[maybe_unused]] const char *file_name,
+               [[maybe_unused]] const char * func_declaration, [[maybe_unused]] const int line)
 {
-    struct Stack *stack = Stacks + stack_descriptor;
+    STACK_DESCRIPTOR_VERIFICATION(context, stack_descriptor);
 
-    STACK_DESCRIPTOR_VERIFICATION(stack_descriptor);
+    struct Stack *stack = context->stacks + stack_descriptor;
 
     assert(stack);
     assert(Stack_Name);
     assert(file_name);
     assert(func_declaration);
 
-    fprintf(LOG_FILE, "Stack[%p] \"%s\" from %s\n"
-                      "In function %s:%d\n", stack, Stack_Name, file_name, func_declaration, line);
-#ifdef PROTECT
+    STACK_LOCK(stack);
+
+    LOG("Stack[%p] \"%s\" from %s\n"
+        "In function %s:%d\n", stack, Stack_Name, file_name, func_declaration, line);
+
+    LOG("{\n");
+
+#if STACK_CANARY
+
+    LOG("\tcanary_left = %#llx;\n", stack->canary_left);
 
-    fprintf(LOG_FILE, "{                     \n"
-                      "\tcanary_left = %#llx;\n"
-                      "\terr         = %u;   \n"
-                      "\tdata_hash   = %zu;  \n"
-                      "\tstack_hash  = %zu;  \n", stack->canary_left, *(const unsigned int *)(&stack->err),
-                                                  stack->data_hash  , stack->stack_hash);
 #endif
 
-    fprintf(LOG_FILE, "\tsize        = %zu;  \n"
-                      "\tcapacity    = %zu;  \n"
-                      "\tdata[%p]            \n", stack->size, stack->capacity, stack->data);
+#if STACK_PROTECT
+
+    LOG("\terr         = %u;   \n", *(const unsigned int *)(&stack->err));
+
+#endif
+
+#if STACK_HASH
+
+    LOG("\tdata_hash   = %zu;  \n"
+        "\tstack_hash  = %zu;  \n", stack->data_hash, stack->stack_hash);
+
+#endif
+
+    LOG("\tsize        = %zu;  \n"
+        "\tcapacity    = %zu;  \n"
+        "\tdata[%p]            \n", stack->size, stack->capacity, stack->data);
 
     if(stack->data != NULL && stack->capacity != 0)
     {
-        fprintf(LOG_FILE, "\t{\n");
+        LOG("\t{\n");
 
-#ifdef PROTECT
+#if STACK_CANARY
 
-        fprintf(LOG_FILE, "\t\t CANARY_LEFT  = %#llx;\n", ((canary_t *)stack->data)[-1]);
+        LOG("\t\t CANARY_LEFT  = %#llx;\n", ((canary_t *)stack->data)[-1]);
 
 #endif
 
         for(size_t i = 0; i < stack->capacity; i++)
         {
-            fprintf(LOG_FILE, "\t\t");
-            fprintf(LOG_FILE, (i < stack->size) ? "*" : " ");
-            fprintf(LOG_FILE, "[%3zu] = "ETS",\n", i, stack->data[i]);
+            LOG("\t\t");
+            LOGS((i < stack->size) ? "*" : " ");
+            LOG("[%3zu] = " ETS ",\n", i, stack->data[i]);
         }
 
-#ifdef PROTECT
+#if STACK_CANARY
 
-        fprintf(LOG_FILE, "\t\t CANARY_RIGHT = %#llx;\n", *(canary_t *)(stack->data + stack->capacity));
+        LOG("\t\t CANARY_RIGHT = %#llx;\n", *(canary_t *)(stack->data + stack->capacity));
 
 #endif
 
-        fprintf(LOG_FILE, "\t};\n");
+        LOG("\t};\n");
 
-#ifdef PROTECT
+#if STACK_CANARY
 
-        fprintf(LOG_FILE, "\tcanary_right = %#llx;\n", stack->canary_right);
+        LOG("\tcanary_right = %#llx;\n", stack->canary_right);
 
 #endif
 
     }
-    fprintf(LOG_FILE, "}\n");
+    LOG("}\n");
 
     return EXIT_SUCCESS;
 }
 
-struct Stack stack_info(const stk_d stack_descriptor)
+struct Stack stack_info(Stack_context *context, const stk_d stack_descriptor)
 {
-    if(stack_descriptor >= N_buffered_stacks)
+    if(stack_descriptor >= context->n_buffered_stacks)
     {
-        fprintf(LOG_FILE, "%s: In %s: error: Invalid stack descriptor.\n", __FILE__, __PRETTY_FUNCTION__); \
+        LOG("%s: In %s: error: Invalid stack descriptor.\n", __FILE__, __PRETTY_FUNCTION__);
 
         return {};
     }
 
-    struct Stack stack = *(Stacks + stack_descriptor);
+    STACK_LOCK((context->stacks + stack_descriptor));
+
+    struct Stack stack = *(context->stacks + stack_descriptor);
     stack.data = NULL;
 
     return stack;
 }
 
-#ifdef PROTECT
+int stack_find(Stack_context *context, const stk_d stack_descriptor, const elem_t val, size_t *index)
+{
+    assert(index);
+
+    STACK_DESCRIPTOR_VERIFICATION(context, stack_descriptor);
+
+    struct Stack *stack = context->stacks + stack_descriptor;
+
+    STACK_LOCK(stack);
+
+    VERIFICATION(context, stack_descriptor, EINVAL);
+
+    *index = kernel_find(stack->data, stack->size, val);
+
+    return (*index == stack->size) ? ENOENT : EXIT_SUCCESS;
+}
+
+int stack_count(Stack_context *context, const stk_d stack_descriptor, const elem_t val, size_t *count)
+{
+    assert(count);
+
+    STACK_DESCRIPTOR_VERIFICATION(context, stack_descriptor);
+
+    struct Stack *stack = context->stacks + stack_descriptor;
+
+    STACK_LOCK(stack);
+
+    VERIFICATION(context, stack_descriptor, EINVAL);
+
+    *count = kernel_count(stack->data, stack->size, val);
+
+    return EXIT_SUCCESS;
+}
+
+int stack_reduce(Stack_context *context, const stk_d stack_descriptor, const Reduce_op op, elem_t *result)
+{
+    assert(result);
+
+    STACK_DESCRIPTOR_VERIFICATION(context, stack_descriptor);
+
+    struct Stack *stack = context->stacks + stack_descriptor;
+
+    STACK_LOCK(stack);
+
+    VERIFICATION(context, stack_descriptor, EINVAL);
+
+    if(op != REDUCE_SUM && stack->size == 0)
+    {
+        LOG("Error: reduction of empty stack.\n"
+            "%s: In function %s\n", __FILE__, __PRETTY_FUNCTION__);
+
+        return EINVAL;
+    }
+
+    switch(op)
+    {
+        case REDUCE_SUM:
+            *result = kernel_sum(stack->data, stack->size);
+            break;
+        case REDUCE_MIN:
+            *result = kernel_min(stack->data, stack->size);
+            break;
+        case REDUCE_MAX:
+            *result = kernel_max(stack->data, stack->size);
+            break;
+        default:
+            LOG("Error: unknown reduce operation %d.\n"
+                "%s: In function %s\n", (int)op, __FILE__, __PRETTY_FUNCTION__);
+
+            return EINVAL;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+std::span<const elem_t> stack_view(Stack_context *context, const stk_d stack_descriptor)
+{
+#if STACK_PROTECT
+
+    if(stack_descriptor_validation(context, stack_descriptor) || stack_quarantined(context, stack_descriptor))
+    {
+        return {};
+    }
+
+    int invalid = stack_audited(context) ? stack_audited_validation(context, stack_descriptor) :
+                                           (stack_validation(context, stack_descriptor) || stack_data_validation(context, stack_descriptor));
+    if(invalid)
+    {
+        stack_error(context, stack_descriptor, EINVAL, __FILE__, __PRETTY_FUNCTION__, __LINE__);
+
+        return {};
+    }
+
+#endif
 
-int stack_descriptor_validation(const stk_d stack_descriptor)
+    struct Stack *stack = context->stacks + stack_descriptor;
+
+    STACK_LOCK(stack);
+
+    return {stack->data, stack->size};
+}
+
+int stack_error(Stack_context *context, const stk_d stack_descriptor, const int err_code, const char *file, const char *func, const int line)
 {
-    return (stack_descriptor >= N_buffered_stacks);
+    stack_error_logged(context, stack_descriptor, err_code, file, func, line);
+
+    return err_code;
 }
-void stack_validation(const stk_d stack_descriptor)
+
+bool stack_error_logged(Stack_context *context, const stk_d stack_descriptor, const int err_code, const char *file, const char *func, const int line)
 {
-    assert(Stacks);
+    Stack_error error = {stack_descriptor, err_code, 0, 0, 0, file, func, line, 0, false};
+
+    FILE *sink = Config.log ? LOG_FILE : stderr; // Without logging the log-file is not even opened.
+
+    if(stack_descriptor == 0 || stack_descriptor >= context->max_stacks)
+    {
+        report_stack_error(&context->reporter, &error, sink);
+
+        return error.logged;
+    }
 
-    struct Stack *stack = Stacks + stack_descriptor;
+#if STACK_PROTECT
+
+    struct Stack *stack = context->stacks + stack_descriptor;
+
+    STACK_LOCK(stack);
+
+    error.err_bits = *(const unsigned int *)(&stack->err);
+
+#if STACK_HASH
+
+    error.stack_hash = stack->stack_hash;
+    error.data_hash  = stack->data_hash;
+
+#endif
+
+    if(report_stack_error(&context->reporter, &error, sink) == ERROR_QUARANTINE)
+    {
+        __atomic_store_n(&stack->quarantined, true, __ATOMIC_RELEASE);
+    }
+
+#else
+
+    report_stack_error(&context->reporter, &error, sink);
+
+#endif
+
+    return error.logged;
+}
+
+void stack_error_handler(Stack_context *context, error_handler_t handler)
+{
+    assert(context);
+
+    error_reporter_handler(&context->reporter, handler);
+}
+
+void stack_error_rate_limit(Stack_context *context, const size_t max_per_second)
+{
+    assert(context);
+
+    error_reporter_rate_limit(&context->reporter, max_per_second);
+}
+
+int stack_quarantined(Stack_context *context, const stk_d stack_descriptor)
+{
+#if STACK_PROTECT
+
+    return __atomic_load_n(&context->stacks[stack_descriptor].quarantined, __ATOMIC_ACQUIRE);
+
+#else
+
+    (void)context;
+    (void)stack_descriptor;
+
+    return 0;
+
+#endif
+}
+
+struct Stack *stack_raw(Stack_context *context, const stk_d stack_descriptor)
+{
+    if(stack_descriptor_validation(context, stack_descriptor))
+    {
+        LOG("%s: In %s: error: Invalid stack descriptor.\n", __FILE__, __PRETTY_FUNCTION__);
+
+        return NULL;
+    }
+
+    return context->stacks + stack_descriptor;
+}
+
+int stack_audited_validation(Stack_context *context, const stk_d stack_descriptor)
+{
+#if STACK_PROTECT
+
+    assert(context);
+
+    if(context->stacks[stack_descriptor].data == NULL) return stack_validation(context, stack_descriptor);
+
+    return 0;
+
+#else
+
+    (void)context;
+    (void)stack_descriptor;
+
+    return 0;
+
+#endif
+}
+
+int stack_descriptor_validation(Stack_context *context, const stk_d stack_descriptor)
+{
+    return (stack_descriptor == 0 || stack_descriptor >= context->n_buffered_stacks);
+}
+
+int stack_validation(Stack_context *context, const stk_d stack_descriptor)
+{
+#if STACK_PROTECT
+
+    assert(context);
+
+    struct Stack *stack = context->stacks + stack_descriptor;
+
+    STACK_LOCK(stack);
+
+#if STACK_HASH
 
     size_t hash_val = poly_hash_stack(stack);
 
+#endif
+
     stack->err = {};
 
     stack->err.no_data  = (stack->data == NULL);
@@ -385,24 +895,68 @@ void stack_validation(const stk_d stack_descriptor)
 
     stack->err.overflow = (!stack->err.sizeless && stack->size > stack->capacity);
 
-    stack->err.invalid  = (stack->err.no_data || stack->err.sizeless || stack->err.overflow ||
-                           stack->canary_left != Canary_val || stack->canary_right != Canary_val ||
-                           hash_val != stack->stack_hash);
+    stack->err.invalid  = (stack->err.no_data || stack->err.sizeless || stack->err.overflow);
+
+#if STACK_CANARY
+
+    stack->err.invalid  = (stack->err.invalid || stack->canary_left != Canary_val || stack->canary_right != Canary_val);
+
+#endif
+
+#if STACK_HASH
+
+    stack->err.invalid  = (stack->err.invalid || hash_val != stack->stack_hash);
+
+#endif
+
+    return stack->err.invalid;
+
+#else
+
+    (void)context;
+    (void)stack_descriptor;
+
+    return 0;
+
+#endif
 }
 
-void stack_data_validation(const stk_d stack_descriptor)
+int stack_data_validation(Stack_context *context, const stk_d stack_descriptor)
 {
-    assert(Stacks);
+#if STACK_PROTECT
 
-    struct Stack *stack = Stacks + stack_descriptor;
+    assert(context);
 
-    size_t hash_val = poly_hash_data(stack);
+    struct Stack *stack = context->stacks + stack_descriptor;
 
-    if(((canary_t *)stack->data)[-1] != Canary_val || *(canary_t *)(stack->data + stack->capacity) != Canary_val ||
-         hash_val != stack->data_hash)
-    {
-        stack->err.invalid = true;
-    }
+    STACK_LOCK(stack);
+
+    bool corrupted = false;
+
+#if STACK_CANARY
+
+    corrupted = (((canary_t *)stack->data)[-1] != Canary_val || *(canary_t *)(stack->data + stack->capacity) != Canary_val);
+
+#endif
+
+#if STACK_HASH
+
+    corrupted = (corrupted || poly_hash_data(stack) != stack->data_hash);
+
+#endif
+
+    if(corrupted) stack->err.invalid = true;
+
+    return corrupted;
+
+#else
+
+    (void)context;
+    (void)stack_descriptor;
+
+    return 0;
+
+#endif
 }
 
-#endif
\ No newline at end of file
+}
@@ -0,0 +1,191 @@
+/**
+ * @file stack_audit.cpp
+ * @author GraY
+ * @brief Auditor thread definitions.
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <stdlib.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "../include/stack_audit.h"
+#include "../include/stack_context.h"
+
+inline namespace STACK_ABI_NS
+{
+
+int stack_audited(Stack_context *context)
+{
+    return context->audit_running.load(std::memory_order_relaxed);
+}
+
+#if STACK_PROTECT
+
+/**
+ * @brief Verifies @b Stack and reports it if corrupted. Destructed, quarantined and busy stacks are skipped.
+ * @return bool True if @b Stack is corrupted.
+ */
+static bool audit_stack(Stack_context *context, const stk_d stack_descriptor)
+{
+    struct Stack *stack = stack_raw(context, stack_descriptor);
+
+    assert(stack);
+
+    if(stack_quarantined(context, stack_descriptor)) return false;
+
+#if STACK_THREAD_SAFE
+
+    std::unique_lock<Stack_lock> stack_guard(stack->lock, std::try_to_lock);
+    if(!stack_guard.owns_lock()) return false;
+
+#endif
+
+    if(stack->data == NULL) return false;
+
+    if(!stack_validation(context, stack_descriptor) && !stack_data_validation(context, stack_descriptor)) return false;
+
+    if(stack_error_logged(context, stack_descriptor, EINVAL, __FILE__, __PRETTY_FUNCTION__, __LINE__))
+    {
+        STACK_CONTEXT_DUMP(context, stack_descriptor);
+    }
+
+    return true;
+}
+
+#if STACK_THREAD_SAFE
+
+/**
+ * @brief Auditor thread. Every period verifies stacks from where it stopped last time, until the budget is spent
+ * or every @b Stack is verified.
+ */
+static void auditor(Stack_context *context, const Audit_config config)
+{
+    const std::chrono::milliseconds period(config.period_ms);
+    const std::chrono::microseconds budget((long long)config.period_ms * 10 * config.budget_percent);
+
+    stk_d cursor = 1;
+
+    std::unique_lock<std::mutex> audit_guard(context->audit_lock);
+
+    while(!context->audit_stop)
+    {
+        audit_guard.unlock();
+
+        if(stack_descriptor_validation(context, cursor)) cursor = 1;
+
+        if(!stack_descriptor_validation(context, cursor))
+        {
+            const stk_d first = cursor;
+            const auto  start = std::chrono::steady_clock::now();
+
+            do
+            {
+                audit_stack(context, cursor++);
+
+                if(stack_descriptor_validation(context, cursor)) cursor = 1;
+            }
+            while(cursor != first && std::chrono::steady_clock::now() - start < budget);
+        }
+
+        audit_guard.lock();
+
+        context->audit_wake.wait_for(audit_guard, period, [context]{ return context->audit_stop; });
+    }
+}
+
+#endif
+
+#endif
+
+int stack_audit_start(Stack_context *context, const Audit_config *config)
+{
+#if STACK_PROTECT && STACK_THREAD_SAFE
+
+    if(config == NULL) config = &Default_audit_config;
+
+    if(config->period_ms == 0 || config->budget_percent == 0 || config->budget_percent > 100)
+    {
+        LOG("%s: In %s: error: Invalid auditor period or budget.\n", __FILE__, __PRETTY_FUNCTION__);
+
+        return EINVAL;
+    }
+
+    std::lock_guard<std::mutex> audit_guard(context->audit_lock);
+
+    if(context->auditor.joinable()) return EALREADY;
+
+    context->audit_stop    = false;
+    context->audit_running = true;
+
+    context->auditor = std::thread(auditor, context, *config);
+
+    return EXIT_SUCCESS;
+
+#elif STACK_PROTECT
+
+    (void)context;
+    (void)config;
+
+    LOG("%s: In %s: error: Auditor thread can`t read stack data without STACK_THREAD_SAFE.\n", __FILE__, __PRETTY_FUNCTION__);
+
+    return ENOTSUP;
+
+#else
+
+    (void)context;
+    (void)config;
+
+    LOG("%s: In %s: error: Nothing to audit without protection policies.\n", __FILE__, __PRETTY_FUNCTION__);
+
+    return ENOTSUP;
+
+#endif
+}
+
+int stack_audit_stop(Stack_context *context)
+{
+    std::unique_lock<std::mutex> audit_guard(context->audit_lock);
+
+    if(!context->auditor.joinable()) return ESRCH;
+
+    std::thread auditor_thread = std::move(context->auditor);
+
+    context->audit_stop    = true;
+    context->audit_running = false;
+
+    audit_guard.unlock();
+
+    context->audit_wake.notify_all();
+
+    auditor_thread.join();
+
+    return EXIT_SUCCESS;
+}
+
+size_t stack_audit_pass(Stack_context *context)
+{
+    size_t n_corrupted = 0;
+
+#if STACK_PROTECT
+
+    for(stk_d stack_descriptor = 1; !stack_descriptor_validation(context, stack_descriptor); stack_descriptor++)
+    {
+        if(audit_stack(context, stack_descriptor)) n_corrupted++;
+    }
+
+#else
+
+    (void)context;
+
+#endif
+
+    return n_corrupted;
+}
+
+}
@@ -0,0 +1,244 @@
+/**
+ * @file stack_vm.cpp
+ * @author GraY
+ * @brief Bytecode evaluator definitions.
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <stdlib.h>
+
+#include "../include/stack.h"
+#include "../include/stack_context.h"
+#include "../include/stack_vm.h"
+
+#define WRAP(a, op, b) (elem_t)((unsigned long long)(a) op (unsigned long long)(b))
+
+/**
+ * @brief Returns from @b run_block() with error, leaving @b stack consistent.
+ */
+#define VM_ERROR(err_code)  { \
+                                stack->size = size; \
+                                *pc_ptr     = pc; \
+                                \
+                                return stack_error(context, stack_descriptor, err_code, __FILE__, __PRETTY_FUNCTION__, __LINE__); \
+                            }
+
+#define VM_NEED(n_elems) if(size < (n_elems)) VM_ERROR(ERANGE)
+
+#define VM_POP_TO(var)  elem_t var = data[--size]; \
+                        data[size] = 0
+
+inline namespace STACK_ABI_NS
+{
+
+/**
+ * @brief Checks basic block starting at @b pc and counts max number of elements it pushes over the current size.
+ * @return int Error code. @b ENOEXEC on unknown instruction or jump outside the @b code.
+ */
+static int block_growth(const Vm_instr *code, const size_t n_instrs, size_t pc, size_t *growth)
+{
+    long long depth     = 0;
+    long long max_depth = 0;
+
+    for(; pc < n_instrs; pc++)
+    {
+        switch(code[pc].op)
+        {
+            case VM_PUSH:
+            case VM_DUP:
+            case VM_OVER:
+                depth++;
+                break;
+            case VM_POP:
+            case VM_ADD:
+            case VM_SUB:
+            case VM_MUL:
+            case VM_DIV:
+            case VM_MOD:
+                depth--;
+                break;
+            case VM_SWAP:
+            case VM_NEG:
+                break;
+            case VM_JMP:
+            case VM_JZ:
+            case VM_JNZ:
+                if(code[pc].arg < 0 || (size_t)code[pc].arg > n_instrs) return ENOEXEC;
+
+                *growth = (size_t)max_depth;
+                return EXIT_SUCCESS;
+            case VM_HALT:
+                *growth = (size_t)max_depth;
+                return EXIT_SUCCESS;
+            default:
+                return ENOEXEC;
+        }
+
+        if(depth > max_depth) max_depth = depth;
+    }
+
+    *growth = (size_t)max_depth;
+
+    return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Runs basic block starting at @b *pc_ptr without verification. Capacity should be reserved beforehand.
+ * Writes index of the next instruction to @b *pc_ptr.
+ */
+static int run_block(Stack_context *context, const stk_d stack_descriptor, Stack *stack, const Vm_instr *code, const size_t n_instrs, size_t *pc_ptr)
+{
+    elem_t *data = stack->data;
+    size_t  size = stack->size;
+    size_t  pc   = *pc_ptr;
+
+    for(; pc < n_instrs; pc++)
+    {
+        switch(code[pc].op)
+        {
+            case VM_HALT:
+                stack->size = size;
+                *pc_ptr     = n_instrs;
+
+                return EXIT_SUCCESS;
+            case VM_PUSH:
+                data[size++] = code[pc].arg;
+                break;
+            case VM_POP:
+            {
+                VM_NEED(1);
+                VM_POP_TO(val);
+                (void)val;
+                break;
+            }
+            case VM_DUP:
+                VM_NEED(1);
+                data[size] = data[size - 1];
+                size++;
+                break;
+            case VM_SWAP:
+            {
+                VM_NEED(2);
+                elem_t temp = data[size - 1];
+                data[size - 1] = data[size - 2];
+                data[size - 2] = temp;
+                break;
+            }
+            case VM_OVER:
+                VM_NEED(2);
+                data[size] = data[size - 2];
+                size++;
+                break;
+            case VM_ADD:
+            {
+                VM_NEED(2);
+                VM_POP_TO(b);
+                data[size - 1] = WRAP(data[size - 1], +, b);
+                break;
+            }
+            case VM_SUB:
+            {
+                VM_NEED(2);
+                VM_POP_TO(b);
+                data[size - 1] = WRAP(data[size - 1], -, b);
+                break;
+            }
+            case VM_MUL:
+            {
+                VM_NEED(2);
+                VM_POP_TO(b);
+                data[size - 1] = WRAP(data[size - 1], *, b);
+                break;
+            }
+            case VM_DIV:
+            case VM_MOD:
+            {
+                VM_NEED(2);
+                if(data[size - 1] == 0) VM_ERROR(EDOM);
+
+                VM_POP_TO(b);
+                elem_t a = data[size - 1];
+
+                if(b == -1) data[size - 1] = (code[pc].op == VM_DIV) ? WRAP(0, -, a) : 0;
+                else        data[size - 1] = (code[pc].op == VM_DIV) ? a / b : a % b;
+
+                break;
+            }
+            case VM_NEG:
+                VM_NEED(1);
+                data[size - 1] = WRAP(0, -, data[size - 1]);
+                break;
+            case VM_JMP:
+                stack->size = size;
+                *pc_ptr     = (size_t)code[pc].arg;
+
+                return EXIT_SUCCESS;
+            case VM_JZ:
+            case VM_JNZ:
+            {
+                VM_NEED(1);
+                VM_POP_TO(cond);
+
+                stack->size = size;
+                *pc_ptr     = ((cond == 0) == (code[pc].op == VM_JZ)) ? (size_t)code[pc].arg : pc + 1;
+
+                return EXIT_SUCCESS;
+            }
+            default:
+                VM_ERROR(ENOEXEC);
+        }
+    }
+
+    stack->size = size;
+    *pc_ptr     = pc;
+
+    return EXIT_SUCCESS;
+}
+
+int stack_vm_run(Stack_context *context, const stk_d stack_descriptor, const Vm_instr *code, const size_t n_instrs)
+{
+    assert(code || n_instrs == 0);
+
+    STACK_DESCRIPTOR_VERIFICATION(context, stack_descriptor);
+
+    struct Stack *stack = stack_raw(context, stack_descriptor);
+
+    STACK_LOCK(stack);
+
+    size_t pc = 0;
+    while(pc < n_instrs)
+    {
+        VERIFICATION(context, stack_descriptor, EINVAL);
+
+        size_t growth   = 0;
+        int    err_code = 0;
+
+        if((err_code = block_growth(code, n_instrs, pc, &growth)))
+        {
+            return stack_error(context, stack_descriptor, err_code, __FILE__, __PRETTY_FUNCTION__, __LINE__);
+        }
+
+        if(stack->capacity - stack->size < growth && (err_code = stack_reserve(context, stack_descriptor, growth)))
+        {
+            LOG("%s: In function %s:%d\n", __FILE__, __PRETTY_FUNCTION__, __LINE__ - 2);
+
+            return err_code;
+        }
+
+        err_code = run_block(context, stack_descriptor, stack, code, n_instrs, &pc);
+
+        HASH_STACK(stack);
+
+        if(err_code) return err_code;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+}
+
+#undef WRAP
+#undef VM_ERROR
+#undef VM_NEED
+#undef VM_POP_TO